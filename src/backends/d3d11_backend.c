@@ -9,6 +9,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "common.h"
+#include "systems/render_stats.h"
 
 #include "sokol_gfx.h"
 #include "sokol_gp.h"
@@ -57,9 +58,7 @@ bool renderer_init(AppState* state) {
         return false;
     }
 
-    sgp_desc sgpdesc = {0};
-    sgp_setup(&sgpdesc);
-    if (!sgp_is_valid()) {
+    if (!renderer_sgp_setup(state, RENDER_SGP_VERTICES, RENDER_SGP_COMMANDS)) {
         fprintf(stderr, "Failed to create Sokol GP context: %s\n", 
                 sgp_get_error_message(sgp_get_last_error()));
         sg_shutdown();
@@ -92,8 +91,8 @@ void renderer_begin_frame(AppState* state) {
     D3D11_VIEWPORT viewport = {
         .TopLeftX = 0.0f,
         .TopLeftY = 0.0f,
-        .Width = (float)state->width,
-        .Height = (float)state->height,
+        .Width = (float)state->renderer.surface_width,
+        .Height = (float)state->renderer.surface_height,
         .MinDepth = 0.0f,
         .MaxDepth = 1.0f
     };
@@ -129,18 +128,26 @@ void renderer_resize(AppState* state, int width, int height) {
         return;
     }
 
-    // Update state dimensions
-    state->width = width;
-    state->height = height;
+    state->renderer.surface_width = width;
+    state->renderer.surface_height = height;
 
     // Recreate render targets
     d3d11_create_render_targets();
 }
 
+// the immediate context isn't bound to a thread, it just must not be used from two at once
+void renderer_acquire_context(AppState* state) {
+    (void)state;
+}
+
+void renderer_release_context(AppState* state) {
+    (void)state;
+}
+
 sg_swapchain get_swapchain(AppState* state) {
     return (sg_swapchain){
-        .width = state->width,
-        .height = state->height,
+        .width = state->renderer.surface_width,
+        .height = state->renderer.surface_height,
         .sample_count = 1,
         .color_format = SG_PIXELFORMAT_BGRA8,
         .depth_format = SG_PIXELFORMAT_DEPTH_STENCIL,
@@ -183,8 +190,8 @@ static bool d3d11_create_device_and_swapchain(AppState* state) {
 
     DXGI_SWAP_CHAIN_DESC swap_desc = {
         .BufferDesc = {
-            .Width = (UINT)state->width,
-            .Height = (UINT)state->height,
+            .Width = (UINT)state->pixel_width,
+            .Height = (UINT)state->pixel_height,
             .RefreshRate = { .Numerator = 60, .Denominator = 1 },
             .Format = DXGI_FORMAT_B8G8R8A8_UNORM
         },
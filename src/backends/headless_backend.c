@@ -0,0 +1,292 @@
+#ifdef RENDER_HEADLESS
+
+// renders without a window, for golden image tests and render benchmarks on machines
+// without a gpu. with SOKOL_GLCORE a surfaceless EGL context (mesa's llvmpipe on ci) draws
+// into an offscreen framebuffer that frames can be read back from. with
+// SOKOL_DUMMY_BACKEND nothing is drawn at all, which leaves just the cpu side to time
+
+#include "sokol_gfx.h"
+#include "sokol_gp.h"
+#include "sokol_log.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "systems/render_system.h"
+#include "systems/render_stats.h"
+#include "stb_image_write.h"
+
+#ifdef SOKOL_GLCORE
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
+HeadlessOptions headless_options = { .frames = 0, .capture_frame = -1 };
+
+typedef struct {
+#ifdef SOKOL_GLCORE
+    EGLDisplay display;
+    EGLContext context;
+    GLuint framebuffer;
+    GLuint colour;         // renderbuffers
+    GLuint depth_stencil;
+#endif
+    int frame;             // frames drawn so far
+    Uint64 frame_start;
+    Uint64 total_ticks;    // time spent between begin and end frame
+    bool initialized;
+} headless_context_t;
+
+static headless_context_t g_headless = {0};
+
+void headless_parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headless_options.frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--capture") == 0 && i + 2 < argc) {
+            headless_options.capture_frame = atoi(argv[++i]);
+            headless_options.capture_path = argv[++i];
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            headless_options.print_stats = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            i++;
+            headless_options.record = strcmp(argv[i], "png") == 0 ? FRAME_CAPTURE_PNG : FRAME_CAPTURE_RAW;
+        } else {
+            fprintf(stderr, "Unknown argument %s (--frames N, --capture FRAME FILE.png, --stats, --record raw|png)\n", argv[i]);
+        }
+    }
+}
+
+#ifdef SOKOL_GLCORE
+static bool egl_init(void) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (!get_platform_display) {
+        fprintf(stderr, "EGL_EXT_platform_base is not supported\n");
+        return false;
+    }
+
+    g_headless.display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (g_headless.display == EGL_NO_DISPLAY || !eglInitialize(g_headless.display, NULL, NULL)) {
+        fprintf(stderr, "Failed to open a surfaceless EGL display: 0x%x\n", eglGetError());
+        return false;
+    }
+
+    EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint config_count = 0;
+    if (!eglChooseConfig(g_headless.display, config_attribs, &config, 1, &config_count) || config_count == 0) {
+        fprintf(stderr, "No suitable EGL config: 0x%x\n", eglGetError());
+        return false;
+    }
+
+    // the shaders are compiled for glsl 410
+    eglBindAPI(EGL_OPENGL_API);
+    EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 1,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    g_headless.context = eglCreateContext(g_headless.display, config, EGL_NO_CONTEXT, context_attribs);
+    if (g_headless.context == EGL_NO_CONTEXT) {
+        fprintf(stderr, "Failed to create EGL context: 0x%x\n", eglGetError());
+        return false;
+    }
+
+    if (!eglMakeCurrent(g_headless.display, EGL_NO_SURFACE, EGL_NO_SURFACE, g_headless.context)) {
+        fprintf(stderr, "Failed to make EGL context current: 0x%x\n", eglGetError());
+        return false;
+    }
+    return true;
+}
+
+// the offscreen target stands in for the window's default framebuffer
+static void resize_framebuffer(int width, int height) {
+    if (!g_headless.framebuffer) {
+        glGenFramebuffers(1, &g_headless.framebuffer);
+        glGenRenderbuffers(1, &g_headless.colour);
+        glGenRenderbuffers(1, &g_headless.depth_stencil);
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, g_headless.colour);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, g_headless.depth_stencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, g_headless.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_headless.colour);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, g_headless.depth_stencil);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        fprintf(stderr, "Offscreen framebuffer is incomplete\n");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // sokol caches gl bindings, it has to forget the ones made behind its back
+    if (sg_isvalid()) {
+        sg_reset_state_cache();
+    }
+}
+
+static void write_png(int width, int height, const char* path) {
+    unsigned char* pixels = malloc((size_t)width * height * 4);
+    if (!pixels) {
+        return;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, g_headless.framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    sg_reset_state_cache();
+
+    // gl rows start at the bottom
+    stbi_flip_vertically_on_write(1);
+    if (stbi_write_png(path, width, height, 4, pixels, width * 4)) {
+        printf("Wrote frame %d to %s\n", g_headless.frame, path);
+    } else {
+        fprintf(stderr, "Failed to write %s\n", path);
+    }
+    free(pixels);
+}
+#endif
+
+bool renderer_init(void* appstate) {
+    AppState* state = (AppState*) appstate;
+#ifdef SOKOL_GLCORE
+    if (!egl_init()) {
+        return false;
+    }
+    resize_framebuffer(state->pixel_width, state->pixel_height);
+#endif
+
+    sg_setup(&(sg_desc){
+        .logger.func = slog_func,
+    });
+    if (!sg_isvalid()) {
+        fprintf(stderr, "Failed to initialize Sokol GFX\n");
+        return false;
+    }
+
+    if (!renderer_sgp_setup(state, RENDER_SGP_VERTICES, RENDER_SGP_COMMANDS)) {
+        fprintf(stderr, "Failed to create Sokol GP context: %s\n",
+                sgp_get_error_message(sgp_get_last_error()));
+        sg_shutdown();
+        return false;
+    }
+
+    g_headless.initialized = true;
+    printf("Headless backend initialized (%dx%d)\n", state->width, state->height);
+    return true;
+}
+
+void renderer_shutdown(void* appstate) {
+    (void)appstate;
+
+    if (g_headless.frame > 0) {
+        double ms = (double)g_headless.total_ticks * 1000.0 / SDL_GetPerformanceFrequency();
+        printf("Rendered %d frames, %.3f ms per frame\n", g_headless.frame, ms / g_headless.frame);
+    }
+
+    if (g_headless.initialized) {
+        sgp_shutdown();
+        sg_shutdown();
+    }
+
+#ifdef SOKOL_GLCORE
+    if (g_headless.framebuffer) {
+        glDeleteFramebuffers(1, &g_headless.framebuffer);
+        glDeleteRenderbuffers(1, &g_headless.colour);
+        glDeleteRenderbuffers(1, &g_headless.depth_stencil);
+    }
+    if (g_headless.display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(g_headless.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (g_headless.context != EGL_NO_CONTEXT) {
+            eglDestroyContext(g_headless.display, g_headless.context);
+        }
+        eglTerminate(g_headless.display);
+    }
+#endif
+
+    memset(&g_headless, 0, sizeof(g_headless));
+}
+
+void renderer_acquire_context(AppState* state) {
+    (void)state;
+#ifdef SOKOL_GLCORE
+    eglMakeCurrent(g_headless.display, EGL_NO_SURFACE, EGL_NO_SURFACE, g_headless.context);
+#endif
+}
+
+void renderer_release_context(AppState* state) {
+    (void)state;
+#ifdef SOKOL_GLCORE
+    eglMakeCurrent(g_headless.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+#endif
+}
+
+void renderer_begin_frame(void* appstate) {
+    renderer_acquire_context((AppState*) appstate);
+    g_headless.frame_start = SDL_GetPerformanceCounter();
+}
+
+void renderer_end_frame(void* appstate) {
+    AppState* state = (AppState*) appstate;
+    g_headless.total_ticks += SDL_GetPerformanceCounter() - g_headless.frame_start;
+
+    if (headless_options.print_stats) {
+        printf("frame %d: %u draw calls, %u vertices, %u texture binds, sokol_gp %u/%u vertices "
+               "(peak %u, %u overflows)\n", g_headless.frame,
+               render_stats_last.draw_calls, render_stats_last.vertices, render_stats_last.texture_binds,
+               render_stats_last.sgp_vertices, render_stats_last.sgp_capacity, render_stats_last.sgp_peak,
+               render_stats_last.sgp_overflows);
+    }
+
+#ifdef SOKOL_GLCORE
+    if (g_headless.frame == headless_options.capture_frame && headless_options.capture_path) {
+        write_png(state->renderer.surface_width, state->renderer.surface_height, headless_options.capture_path);
+    }
+#else
+    (void)state;
+    if (g_headless.frame == headless_options.capture_frame) {
+        fprintf(stderr, "Frame capture needs the EGL build, nothing is drawn with the dummy backend\n");
+    }
+#endif
+    g_headless.frame++;
+}
+
+void renderer_resize(void* appstate, int width, int height) {
+    AppState* state = (AppState*) appstate;
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+#ifdef SOKOL_GLCORE
+    resize_framebuffer(width, height);
+#endif
+    state->renderer.surface_width = width;
+    state->renderer.surface_height = height;
+}
+
+sg_swapchain get_swapchain(AppState* state) {
+    sg_swapchain swapchain = {0};
+    swapchain.width = state->renderer.surface_width;
+    swapchain.height = state->renderer.surface_height;
+    swapchain.sample_count = 1;
+    swapchain.color_format = SG_PIXELFORMAT_RGBA8;
+    swapchain.depth_format = SG_PIXELFORMAT_DEPTH_STENCIL;
+#ifdef SOKOL_GLCORE
+    swapchain.gl.framebuffer = g_headless.framebuffer;
+#endif
+    return swapchain;
+}
+
+#endif // RENDER_HEADLESS
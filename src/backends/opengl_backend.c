@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "common.h"
+#include "systems/render_stats.h"
 
 typedef struct {
     SDL_GLContext gl_context;
@@ -47,9 +48,7 @@ bool renderer_init(AppState* state) {
     }
 
     // Initialize Sokol GP
-    sgp_desc sgpdesc = {0};
-    sgp_setup(&sgpdesc);
-    if (!sgp_is_valid()) {
+    if (!renderer_sgp_setup(state, RENDER_SGP_VERTICES, RENDER_SGP_COMMANDS)) {
         fprintf(stderr, "Failed to create Sokol GP context: %s\n", 
                 sgp_get_error_message(sgp_get_last_error()));
         sg_shutdown();
@@ -103,17 +102,24 @@ void renderer_end_frame(AppState* state) {
     SDL_GL_SwapWindow(state->window);
 }
 
+// called from the thread that draws, the default framebuffer follows the window by itself
 void renderer_resize(AppState* state, int width, int height) {
     if (!g_gl_ctx.initialized) {
         return;
     }
 
-    // Make context current
-    SDL_GL_MakeCurrent(state->window, g_gl_ctx.gl_context);
+    state->renderer.surface_width = width;
+    state->renderer.surface_height = height;
+}
+
+void renderer_acquire_context(AppState* state) {
+    if (g_gl_ctx.gl_context) {
+        SDL_GL_MakeCurrent(state->window, g_gl_ctx.gl_context);
+    }
+}
 
-    // Update state dimensions
-    state->width = width;
-    state->height = height;
+void renderer_release_context(AppState* state) {
+    SDL_GL_MakeCurrent(state->window, NULL);
 }
 
 sg_swapchain get_swapchain(AppState* state) {
@@ -123,8 +129,8 @@ sg_swapchain get_swapchain(AppState* state) {
         return empty;
     }
     
-    int width = state->width;
-    int height = state->height;
+    int width = state->renderer.surface_width;
+    int height = state->renderer.surface_height;
     
     // Handle minimized window case
     if (width <= 0 || height <= 0) {
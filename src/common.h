@@ -5,6 +5,16 @@
 #include <flecs.h>
 #include "font_rendering.h"
 #include "util/sprite_loader.h"
+#include "util/pathfinding.h"
+#include "systems/sprite_batch.h"
+#include "util/tilemap.h"
+#include "systems/render_thread.h"
+#include "util/job_pool.h"
+#include "systems/iso_render.h"
+#include "systems/render_scale.h"
+#include "systems/particles.h"
+#include "systems/ui.h"
+#include "components/animation.h"
 
 #define TILE_SIZE 32
 typedef struct {
@@ -26,10 +36,19 @@ typedef struct {
 typedef struct {
     RenderQueries queries;
     text_renderer_t* text_renderer;
-    sg_shader sprite_shader;
+    SpriteBatch sprites;  // instanced sprite shader, pipeline and instance buffer
+    RenderThread thread;  // owns the gpu context once started, see render_thread.h
+    int surface_width, surface_height;  // size the backbuffer was last set up for, in pixels
+    RenderScale scale;    // fraction of the backbuffer the world is drawn at
+    SceneTarget scene;    // where the world goes when that's below 1
+    FrameCapture capture; // frames recorded to disk, driven by the packets
     sg_shader particle_shader;
-    sg_pipeline sprite_pipeline;
     sg_pipeline particle_pipeline;
+    sg_buffer particle_buffer;  // instances of the particles in view, see particles.h
+    UiCache ui;           // the ui as last drawn, composited over each frame
+    uint32_t sgp_vertices;   // sokol_gp's capacities, grown by renderer_sgp_reserve
+    uint32_t sgp_commands;
+    sgp_error sgp_overflow;  // which of them the last frame ran out of, as renderer_sgp_check saw it
     // other render state
 } Renderer;
 
@@ -38,14 +57,47 @@ typedef struct {
     ecs_entity_t value;
 } GridEntry;
 
+// drawable entities bucketed by grid chunk, so the renderer only visits what is on screen
+typedef struct {
+    uint64_t key;
+    ecs_entity_t* value;  // stb_ds array
+} GridChunk;
+
+// what a grid chunk holds, for drawing it as a single tile when zoomed far out. only
+// recounted when an entity enters or leaves the chunk
+typedef struct {
+    int belts, items, others;
+    uint8_t colour[4];
+    bool dirty;
+} ChunkLod;
+
+typedef struct {
+    uint64_t key;
+    ChunkLod value;
+} GridChunkLod;
+
+typedef struct {
+    float x, y;     // world position at the centre of the screen
+    float zoom;     // screen pixels per world pixel
+    int viewport_w, viewport_h;
+} Camera;
+
+// stb_ds hashmap used as a set of tiles, keyed like the grid
+typedef struct {
+    uint64_t key;
+    bool value;
+} TileFlag;
+
 typedef struct {
     ecs_entity_t* level;
     int map_height;
     int map_width;
+    TileMap tiles;
 } Map;
 typedef struct AppState {
     SDL_Window* window;
-    int width, height;
+    int width, height;  // window size, what the camera and ui work in
+    int pixel_width, pixel_height;  // backbuffer size, larger on high density displays
     const char* title;
     float last_tick;
     float current_tick;
@@ -54,11 +106,24 @@ typedef struct AppState {
     Renderer renderer;
     ecs_world_t* ecs;
     SpriteAtlas sprite_atlas;
+    AnimationSet* animation_sets;  // one per sprite type, indexed like sprite_atlas.entities. stb_ds array
     float ecs_accumulator;
     InputState input;
     Map map;
     GridEntry* grid;
+    GridChunk* grid_chunks;
+    GridChunkLod* chunk_lods;  // keyed like grid_chunks
+    Camera camera;
+    PathGraph pathfinding;
+    Minimap minimap;
+    TileFlag* dirty_belts;  // tiles the belt autotiler resolves next tick
     ecs_entity_t input_component;
+    JobPool jobs;  // worker threads for the cpu side of rendering
+    IsoScene iso;  // draw order for isometric maps
+    ParticlePool particles;  // smoke and sparks, simulated outside the ecs
+    FrameCaptureMode capture_mode;  // toggled with F3, passed to the renderer in each packet
+    UiLayer ui;    // retained widgets, laid out here and drawn by the renderer
+    int fps_label;
   } AppState;
 
 #endif
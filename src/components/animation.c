@@ -1,12 +1,14 @@
 #include "animation.h"
 
 ECS_COMPONENT_DECLARE(AnimationClip);
-ECS_COMPONENT_DECLARE(AnimationSet);
+ECS_COMPONENT_DECLARE(AnimationSetRef);
 ECS_COMPONENT_DECLARE(AnimationState);
+ECS_COMPONENT_DECLARE(ShaderAnimation);
 
 
 void animation_components_register(ecs_world_t *world) {
     ECS_COMPONENT_DEFINE(world, AnimationClip);
-    ECS_COMPONENT_DEFINE(world, AnimationSet);
+    ECS_COMPONENT_DEFINE(world, AnimationSetRef);
     ECS_COMPONENT_DEFINE(world, AnimationState);
+    ECS_COMPONENT_DEFINE(world, ShaderAnimation);
 }
\ No newline at end of file
@@ -2,11 +2,15 @@
 #define ANIMATION_H
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <flecs.h>
 #include "util/sprite_loader.h"
+#include "components/animation_graph.h"
 
 typedef struct {
-    sg_image texture;
+    sg_image texture;          // atlas page
+    int atlas_x, atlas_y;      // where the clip's sheet starts inside the page
+    int shader_clip;           // loop the sprite shader can play on its own, 0 if none
     int frame_count;
     int direction_count;  // 1 or 8
     float frame_time;
@@ -14,24 +18,38 @@ typedef struct {
     int row;  // -1 if direction-based
 } AnimationClip;
 
-// Entity's animation data
+// a sprite type's animations, built once per type (AppState.animation_sets) and shared by
+// every entity of it
 typedef struct {
-    AnimationClip clips[8];  // Max 8 different animations per entity
-    char clip_names[8][64];
+    AnimationClip clips[ANIMATION_MAX_STATES];  // Max 8 different animations per entity
+    char clip_names[ANIMATION_MAX_STATES][64];
     int clip_count;
     int width, height;  // Frame dimensions
+    AnimationGraph graph;  // no transitions if the type has no graph
 } AnimationSet;
 
+// what an entity holds instead of its own copy of the set, an index into AppState.animation_sets
+typedef struct {
+    uint16_t set;
+} AnimationSetRef;
+
 // Current playback state
 typedef struct {
-    int current_clip;  // Index into AnimationSet
+    int current_clip;  // Index into the entity's AnimationSet
     int current_frame;
     float elapsed;
 } AnimationState;
 
+// cosmetic loop played entirely by the sprite shader, used instead of AnimationState so
+// update_animations never visits the entity
+typedef struct {
+    int clip;  // shader clip, see AnimationClip.shader_clip
+} ShaderAnimation;
+
 extern ECS_COMPONENT_DECLARE(AnimationClip);
-extern ECS_COMPONENT_DECLARE(AnimationSet);
+extern ECS_COMPONENT_DECLARE(AnimationSetRef);
 extern ECS_COMPONENT_DECLARE(AnimationState);
+extern ECS_COMPONENT_DECLARE(ShaderAnimation);
 
 void animation_components_register(ecs_world_t *world);
 #endif
@@ -16,31 +16,47 @@ typedef struct {
     AnimationConditionFunc func;
 } ConditionRegistry;
 
-// animation_graph.c - simplified conditions
-bool is_moving(ecs_world_t *world, ecs_entity_t e) {
-    const Velocity *vel = ecs_get(world, e, Velocity);
-    return vel && (vel->x != 0 || vel->y != 0);
+// no Velocity column means neither moving nor idle
+static void is_moving(const AnimationColumns *columns, uint32_t *results, uint32_t bit) {
+    const Velocity *vel = columns->velocity;
+    if (!vel) return;
+    for (int i = 0; i < columns->count; i++) {
+        results[i] |= (vel[i].x != 0 || vel[i].y != 0) ? bit : 0;
+    }
 }
 
-bool is_idle(ecs_world_t *world, ecs_entity_t e) {
-    const Velocity *vel = ecs_get(world, e, Velocity);
-    return vel && vel->x == 0 && vel->y == 0;
+static void is_idle(const AnimationColumns *columns, uint32_t *results, uint32_t bit) {
+    const Velocity *vel = columns->velocity;
+    if (!vel) return;
+    for (int i = 0; i < columns->count; i++) {
+        results[i] |= (vel[i].x == 0 && vel[i].y == 0) ? bit : 0;
+    }
 }
 
-// Simplified registry
-static ConditionRegistry condition_registry[] = {
+// index is the condition's id, at most 32 of them
+static const ConditionRegistry condition_registry[] = {
+    [ANIMATION_CONDITION_COMPLETE] = {"animation_complete", NULL},
     {"is_moving", is_moving},
     {"is_idle", is_idle},
-    {"animation_complete", NULL},
-    {NULL, NULL}
 };
+#define CONDITION_COUNT (int)(sizeof(condition_registry) / sizeof(condition_registry[0]))
+_Static_assert(CONDITION_COUNT <= 32, "conditions are evaluated into a 32 bit mask");
 
-AnimationConditionFunc lookup_condition_function(const char *name) {
-    for (int i = 0; condition_registry[i].name; i++) {
+int lookup_condition(const char *name) {
+    for (int i = 0; i < CONDITION_COUNT; i++) {
         if (strcmp(condition_registry[i].name, name) == 0) {
-            return condition_registry[i].func;
+            return i;
         }
     }
     fprintf(stderr, "Unknown condition: %s\n", name);
-    return NULL;
-}
\ No newline at end of file
+    return -1;
+}
+
+void animation_conditions_evaluate(const AnimationColumns *columns, uint32_t *results) {
+    memset(results, 0, columns->count * sizeof(uint32_t));
+    for (int i = 0; i < CONDITION_COUNT; i++) {
+        if (condition_registry[i].func) {
+            condition_registry[i].func(columns, results, 1u << i);
+        }
+    }
+}
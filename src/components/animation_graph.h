@@ -3,29 +3,54 @@
 
 #include <flecs.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "components/transform.h"
 
-// Condition function type
-typedef bool (*AnimationConditionFunc)(ecs_world_t*, ecs_entity_t);
+// conditions are predicates over component columns. the graph system evaluates every one of
+// them once per batch of an archetype, straight down the batch's arrays, into a bitmask per
+// entity, and transitions only test their condition's bit. transitions sharing a condition
+// share its result
+#define ANIMATION_CONDITION_BATCH 256   // entities evaluated together, sizes the result buffer on the stack
+#define ANIMATION_CONDITION_COMPLETE 0  // the current clip has played out, worked out per entity
 
+// the columns a batch of entities has for conditions to read, NULL where its table has none
 typedef struct {
-    char from[64];
-    char to[64];
-    AnimationConditionFunc condition;
+    const Velocity *velocity;
+    int count;
+} AnimationColumns;
+
+// ors bit into results[i] for every entity i of the batch the condition holds for
+typedef void (*AnimationConditionFunc)(const AnimationColumns *columns, uint32_t *results, uint32_t bit);
+
+#define ANIMATION_MAX_STATES 8  // a graph's states are the clips of an AnimationSet
+
+// a transition with its target resolved to a clip index
+typedef struct {
+    int to;
+    uint32_t condition;  // bit in the batch's results, 1 << condition id
     int priority;
 } AnimationTransition;
 
+// a sprite type's graph, compiled from the definitions once and shared by all its entities.
+// the transitions leaving each state are stored together, highest priority first, with the
+// "*" ones already merged in, so the first that fires is the one taken
 typedef struct {
     AnimationTransition *transitions;
+    int first[ANIMATION_MAX_STATES + 1];  // state s leaves through [first[s], first[s + 1])
     int transition_count;
 } AnimationGraph;
 
 typedef struct {
-    AnimationGraph *graph;
+    const AnimationGraph *graph;  // owned by the sprite type's AnimationSet
 } AnimationGraphComponent;
 
 extern ECS_COMPONENT_DECLARE(AnimationGraphComponent);
 
 void animation_graph_components_register(ecs_world_t *world);
-AnimationConditionFunc lookup_condition_function(const char *name);
+// id of a named condition, -1 if there is no such condition
+int lookup_condition(const char *name);
+// results[i] gets a bit for every condition that holds for entity i of the batch, apart from
+// ANIMATION_CONDITION_COMPLETE which needs the entity's clip
+void animation_conditions_evaluate(const AnimationColumns *columns, uint32_t *results);
 
 #endif
\ No newline at end of file
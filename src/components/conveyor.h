@@ -15,8 +15,14 @@ typedef enum {
     LANE_RIGHT = 1
 } Lane;
 
+// dir is always one of the four cardinals. shape, next and next_lane are owned by the
+// belt autotiler and only change when a neighbouring tile does.
 typedef struct {
-    Direction dir;
+    Direction dir;                   // direction items leave the tile
+    Direction in_dir;                // direction items travel when they enter, differs from dir on a corner
+    Direction shape;                 // sprite variant, a diagonal for corners
+    ecs_entity_t next;               // belt this one feeds into, 0 if none
+    Lane next_lane[CONVEYOR_LANES];  // lane on next that each of our lanes lands on
     ecs_entity_t lane_items[CONVEYOR_LANES][MAX_CONVEYER_ITEMS];
     int lane_item_count[CONVEYOR_LANES];
     bool isCorner;
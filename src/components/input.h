@@ -5,20 +5,38 @@
 #include <SDL3/SDL.h>
 #include "transform.h"
 
+typedef enum {
+    BUILD_PLACE_BELT,
+    BUILD_REMOVE
+} BuildCommandType;
+
+// produced by the input layer, applied by the build system once per tick
+typedef struct {
+    BuildCommandType type;
+    int tile_x, tile_y;
+    Direction dir;
+} BuildCommand;
+
 typedef struct {
-    float mouse_x, mouse_y;
+    float mouse_x, mouse_y;  // screen space
+    float world_x, world_y;  // mouse position through the camera
     bool mouse_left_pressed;
     bool mouse_right_pressed;
+    bool mouse_middle_pressed;  // held to pan the camera
     int grid_x, grid_y; // calculated grid position
     bool valid_grid_pos;
 
-    // events for the frame
-    SDL_Event events[32];
-    int event_count;
+    // drag placement, last tile visited and the direction the run is heading
+    bool dragging;
+    int drag_x, drag_y;
+    Direction place_dir;
+
+    // commands for the frame
+    BuildCommand* commands; // stb_ds array
 } Input;
 
 
 extern ECS_COMPONENT_DECLARE(Input);
 
 void input_components_register(ecs_world_t *world);
-#endif
\ No newline at end of file
+#endif
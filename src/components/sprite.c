@@ -3,9 +3,13 @@
 ECS_COMPONENT_DECLARE(Sprite);
 ECS_COMPONENT_DECLARE(Colour);
 ECS_COMPONENT_DECLARE(RenderLayer);
+ECS_COMPONENT_DECLARE(GridChunkRef);
+ECS_COMPONENT_DECLARE(ParticleEmitter);
 
 void sprite_components_register(ecs_world_t* world) {
     ECS_COMPONENT_DEFINE(world, Sprite);
     ECS_COMPONENT_DEFINE(world, Colour);
     ECS_COMPONENT_DEFINE(world, RenderLayer);
+    ECS_COMPONENT_DEFINE(world, GridChunkRef);
+    ECS_COMPONENT_DEFINE(world, ParticleEmitter);
 }
\ No newline at end of file
@@ -9,14 +9,34 @@ typedef struct {
     float src_x, src_y, src_w, src_h;
     float scale_x, scale_y;
     float rotation;
+    uint8_t palette;  // atlas palette row, only used on indexed pages
 } Sprite;
 
 typedef struct { float r, g, b, a; } Colour;
+// lower layers draw first, inside a layer sprites are ordered by their bottom edge
+enum {
+    RENDER_LAYER_GROUND = 0,
+    RENDER_LAYER_BELTS = 1,
+    RENDER_LAYER_ITEMS = 2,
+    RENDER_LAYER_CHARACTERS = 3,
+    RENDER_LAYER_COUNT
+};
 typedef struct { int layer; } RenderLayer;
+// which grid chunk the entity is currently bucketed in
+typedef struct { int chunk_x, chunk_y; } GridChunkRef;
+// keeps spawning particles (systems/particles.h) from a point relative to the entity's position
+typedef struct {
+    int kind;                  // ParticleKind
+    float rate;                // particles per second
+    float timer;               // fraction of a particle carried to the next tick
+    float offset_x, offset_y;
+} ParticleEmitter;
 
 extern ECS_COMPONENT_DECLARE(Sprite);
 extern ECS_COMPONENT_DECLARE(Colour);
 extern ECS_COMPONENT_DECLARE(RenderLayer);
+extern ECS_COMPONENT_DECLARE(GridChunkRef);
+extern ECS_COMPONENT_DECLARE(ParticleEmitter);
 
 void sprite_components_register(ecs_world_t *world);
 #endif
\ No newline at end of file
@@ -1,6 +1,123 @@
 #include "entity_factory.h"
 
-ecs_entity_t entity_factory_spawn_sprite(AppState* state, const char* sprite_name, float x, float y) {
+// belt animation names indexed by Direction
+static const char* belt_animation_names[8] = {
+    [DIR_UP_LEFT] = "up_left",
+    [DIR_LEFT] = "left",
+    [DIR_DOWN_LEFT] = "down_left",
+    [DIR_DOWN] = "down",
+    [DIR_DOWN_RIGHT] = "down_right",
+    [DIR_RIGHT] = "right",
+    [DIR_UP_RIGHT] = "up_right",
+    [DIR_UP] = "up"
+};
+
+const char* belt_animation_name(Direction dir) {
+    return belt_animation_names[dir];
+}
+
+static void build_animation_set(const LoadedSpriteData* loaded, AnimationSet* anim_set) {
+    memset(anim_set, 0, sizeof(AnimationSet));
+    anim_set->width = loaded->width;
+    anim_set->height = loaded->height;
+    anim_set->clip_count = loaded->clip_count < ANIMATION_MAX_STATES ? loaded->clip_count : ANIMATION_MAX_STATES;
+    
+    for (int i = 0; i < anim_set->clip_count; i++) {
+        anim_set->clips[i].texture = loaded->clips[i].texture;
+        anim_set->clips[i].atlas_x = loaded->clips[i].atlas_x;
+        anim_set->clips[i].atlas_y = loaded->clips[i].atlas_y;
+        anim_set->clips[i].shader_clip = loaded->clips[i].shader_clip;
+        anim_set->clips[i].frame_count = loaded->clips[i].frame_count;
+        anim_set->clips[i].direction_count = loaded->clips[i].direction_count;
+        anim_set->clips[i].frame_time = loaded->clips[i].frame_time;
+        anim_set->clips[i].loop = loaded->clips[i].loop;
+        anim_set->clips[i].row = loaded->clips[i].row;
+        strncpy(anim_set->clip_names[i], loaded->clip_names[i], 63);
+    }
+}
+
+static int find_clip_index(const AnimationSet* anim_set, const char* name) {
+    for (int i = 0; i < anim_set->clip_count; i++) {
+        if (strcmp(anim_set->clip_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// the only place a graph's state names are looked at. everything after works on clip indices
+static void compile_animation_graph(const LoadedSpriteData* loaded, AnimationSet* anim_set) {
+    AnimationGraph* graph = &anim_set->graph;
+    int count = loaded->transition_count;
+    if (!loaded->transitions || count <= 0) {
+        return;
+    }
+
+    // -2 leaves any state, -1 a transition that names a clip or condition that doesn't exist
+    int* from = malloc(count * sizeof(int));
+    int* to = malloc(count * sizeof(int));
+    for (int t = 0; t < count; t++) {
+        const LoadedTransition* lt = &loaded->transitions[t];
+        from[t] = strcmp(lt->from, "*") == 0 ? -2 : find_clip_index(anim_set, lt->from);
+        to[t] = find_clip_index(anim_set, lt->to);
+        if (to[t] < 0 || from[t] == -1) {
+            fprintf(stderr, "%s: dropping transition %s -> %s, no such animation\n", loaded->name, lt->from, lt->to);
+            to[t] = -1;
+        } else if (lt->condition < 0) {
+            fprintf(stderr, "%s: dropping transition %s -> %s, unknown condition\n", loaded->name, lt->from, lt->to);
+            to[t] = -1;
+        }
+    }
+
+    graph->transitions = malloc((size_t)anim_set->clip_count * count * sizeof(AnimationTransition));
+    for (int state = 0; state < anim_set->clip_count; state++) {
+        graph->first[state] = graph->transition_count;
+        for (int t = 0; t < count; t++) {
+            if (to[t] < 0 || (from[t] != -2 && from[t] != state)) {
+                continue;
+            }
+            // insertion keeps definition order among equal priorities, the first of those wins
+            AnimationTransition added = {
+                to[t], 1u << loaded->transitions[t].condition, loaded->transitions[t].priority
+            };
+            int i = graph->transition_count++;
+            while (i > graph->first[state] && graph->transitions[i - 1].priority < added.priority) {
+                graph->transitions[i] = graph->transitions[i - 1];
+                i--;
+            }
+            graph->transitions[i] = added;
+        }
+    }
+    for (int state = anim_set->clip_count; state <= ANIMATION_MAX_STATES; state++) {
+        graph->first[state] = graph->transition_count;
+    }
+
+    free(from);
+    free(to);
+}
+
+void entity_factory_load_animation_sets(AppState* state) {
+    arrsetlen(state->animation_sets, state->sprite_atlas.entity_count);
+    for (int i = 0; i < state->sprite_atlas.entity_count; i++) {
+        build_animation_set(&state->sprite_atlas.entities[i], &state->animation_sets[i]);
+        compile_animation_graph(&state->sprite_atlas.entities[i], &state->animation_sets[i]);
+    }
+}
+
+void entity_factory_free_animation_sets(AppState* state) {
+    for (int i = 0; i < arrlen(state->animation_sets); i++) {
+        free(state->animation_sets[i].graph.transitions);
+    }
+    arrfree(state->animation_sets);
+}
+
+// sets line up with the atlas' sprite types
+static uint16_t animation_set_index(AppState* state, const LoadedSpriteData* loaded) {
+    return (uint16_t)(loaded - state->sprite_atlas.entities);
+}
+
+// the layer is passed in so each entity gets its RenderLayer once
+static ecs_entity_t spawn_sprite(AppState* state, const char* sprite_name, float x, float y, RenderLayer layer) {
     LoadedSpriteData *loaded = sprite_atlas_get(&state->sprite_atlas, sprite_name);
     if (!loaded) {
         fprintf(stderr, "Failed to find sprite: %s\n", sprite_name);
@@ -10,33 +127,14 @@ ecs_entity_t entity_factory_spawn_sprite(AppState* state, const char* sprite_nam
     ecs_entity_t e = ecs_new(state->ecs);
     printf("Created entity: %llu\n", e);
     
-    AnimationSet anim_set = {0};
-    anim_set.width = loaded->width;
-    anim_set.height = loaded->height;
-    anim_set.clip_count = loaded->clip_count;
-    
-    for (int i = 0; i < loaded->clip_count; i++) {
-        anim_set.clips[i].texture = loaded->clips[i].texture;
-        anim_set.clips[i].frame_count = loaded->clips[i].frame_count;
-        anim_set.clips[i].direction_count = loaded->clips[i].direction_count;
-        anim_set.clips[i].frame_time = loaded->clips[i].frame_time;
-        anim_set.clips[i].loop = loaded->clips[i].loop;
-        anim_set.clips[i].row = loaded->clips[i].row;
-        strncpy(anim_set.clip_names[i], loaded->clip_names[i], 63);
-    }
-
-    ecs_set_ptr(state->ecs, e, AnimationSet, &anim_set);
+    uint16_t set = animation_set_index(state, loaded);
+    const AnimationSet* anim_set = &state->animation_sets[set];
+    ecs_set(state->ecs, e, AnimationSetRef, { set });
 
+    int default_idx = find_clip_index(anim_set, loaded->default_animation);
+    if (default_idx < 0) default_idx = 0;
     
-    int default_idx = 0;
-    for (int i = 0; i < anim_set.clip_count; i++) {
-        if (strcmp(anim_set.clip_names[i], loaded->default_animation) == 0) {
-            default_idx = i;
-            break;
-        }
-    }
-    
-    AnimationClip *clip = &anim_set.clips[default_idx];
+    const AnimationClip *clip = &anim_set->clips[default_idx];
     int initial_row = clip->direction_count > 1 ? 2 : (clip->row >= 0 ? clip->row : 0);
 
     ecs_set(state->ecs, e, AnimationState, {
@@ -47,120 +145,206 @@ ecs_entity_t entity_factory_spawn_sprite(AppState* state, const char* sprite_nam
     
     ecs_set(state->ecs, e, Sprite, {
         .texture = clip->texture,
-        .src_x = 0,
-        .src_y = initial_row * loaded->height,
+        .src_x = clip->atlas_x,
+        .src_y = clip->atlas_y + initial_row * loaded->height,
         .src_w = loaded->width,
         .src_h = loaded->height,
         .scale_x = loaded->scale_x,
         .scale_y = loaded->scale_y,
-        .rotation = 0
+        .rotation = 0,
+        // a row past the palette texture would sample outside it
+        .palette = loaded->palette < state->sprite_atlas.palette_count ? (uint8_t)loaded->palette : 0
     });
 
     ecs_set(state->ecs, e, Position, {x, y});
     ecs_set(state->ecs, e, Direction, { DIR_RIGHT});
     ecs_set(state->ecs, e, Velocity, {0, 0});
+    ecs_set_ptr(state->ecs, e, RenderLayer, &layer);
+    grid_chunk_track(state, e, x, y);
     
-    // Copy animation graph if exists
-    if (loaded->transitions && loaded->transition_count > 0) {
-        AnimationGraph *graph = malloc(sizeof(AnimationGraph));
-        graph->transition_count = loaded->transition_count;
-        graph->transitions = malloc(loaded->transition_count * sizeof(AnimationTransition));
-        
-        for (int i = 0; i < loaded->transition_count; i++) {
-            AnimationTransition *t = &graph->transitions[i];
-            strncpy(t->from, loaded->transitions[i].from, 63);
-            strncpy(t->to, loaded->transitions[i].to, 63);
-            t->condition = loaded->transitions[i].condition;
-            t->priority = loaded->transitions[i].priority;
-        }
-        
-        ecs_set_ptr(state->ecs, e, AnimationGraphComponent, &(AnimationGraphComponent){graph});
+    // the graph is the type's, compiled at load
+    if (anim_set->graph.transition_count > 0) {
+        ecs_set(state->ecs, e, AnimationGraphComponent, { &anim_set->graph });
     }
     
     printf("Entity spawn complete\n");
     return e;
 }
 
+ecs_entity_t entity_factory_spawn_sprite(AppState* state, const char* sprite_name, float x, float y) {
+    return spawn_sprite(state, sprite_name, x, y, (RenderLayer){ RENDER_LAYER_CHARACTERS });
+}
+
 ecs_entity_t entity_factory_spawn_belt(AppState* state, float x, float y, Direction dir) {
-    ecs_entity_t belt = entity_factory_spawn_sprite(state, "belt", x, y);
-    // need to do an adjacent tiles check and see 
+    ecs_entity_t belt = spawn_sprite(state, "belt", x, y, (RenderLayer){ RENDER_LAYER_BELTS });
+    // belts are the bulk of the world, their loop runs in the sprite shader
+    ecs_remove(state->ecs, belt, AnimationState);
+    ecs_set(state->ecs, belt, ShaderAnimation, { 0 });
     ecs_set(state->ecs, belt, Conveyor, {
         .dir = dir,
+        .in_dir = dir,
+        .shape = dir,
         .lane_items = {0},
         .lane_item_count = {0}
     });
+    set_sprite_animation(state->ecs, belt, belt_animation_names[dir]);
+    
+    // corners and links are worked out by the autotiler once the tick's placements are in
+    insert_entity_to_grid(state, x, y, belt);
+    belt_autotile_mark_dirty(state, world_to_tile(x), world_to_tile(y));
+    return belt;
+}
+
+int entity_factory_spawn_belts(AppState* state, const BeltPlacement* placements, int count) {
+    LoadedSpriteData *loaded = sprite_atlas_get(&state->sprite_atlas, "belt");
+    if (!loaded || count <= 0) {
+        return 0;
+    }
+
+    // everything that is the same for every belt is resolved once for the batch
+    uint16_t set = animation_set_index(state, loaded);
+    const AnimationSet* anim_set = &state->animation_sets[set];
+
+    int dir_clips[8];
+    for (int d = 0; d < 8; d++) {
+        dir_clips[d] = find_clip_index(anim_set, belt_animation_names[d]);
+        if (dir_clips[d] < 0) dir_clips[d] = 0;
+    }
+    // a row past the palette texture would sample outside it
+    uint8_t palette = loaded->palette < state->sprite_atlas.palette_count ? (uint8_t)loaded->palette : 0;
 
-    // to determine if we need a corner belt, we need to look at the surrounding tiles. 
-    // for example:
-    // [b][x][x]  
-    // [x][x][x]
-    // [x][x][x]
-    // if i place a belt into [0][1], i need to check up, down, right, (ignore origin)
-    // if theres a belt there, then we can go one step further and check
-    // if the belt direction is facing towards the to be placed belt then we just place the DIR.
-    // otherwise we can use the angled dir, 
-    // so if the from direction is 
-    // switch this to updating a string
-
-    // this is a DIR_RIGHT check
-    ecs_entity_t ent = get_entity_at_grid_position(state,  x + 32, y);
-    if ( ent != 0) { 
-        // check if it is a conveyor & direction is the same
-        Conveyor* conv = ecs_get_mut(state->ecs, ent, Conveyor);
-        if (conv == NULL) {
-            // do nothing
+    Position* positions = malloc(count * sizeof(Position));
+    AnimationSetRef* set_refs = malloc(count * sizeof(AnimationSetRef));
+    ShaderAnimation* shader_anims = malloc(count * sizeof(ShaderAnimation));
+    Sprite* sprites = malloc(count * sizeof(Sprite));
+    Direction* directions = malloc(count * sizeof(Direction));
+    Velocity* velocities = malloc(count * sizeof(Velocity));
+    Conveyor* conveyors = malloc(count * sizeof(Conveyor));
+    GridChunkRef* chunk_refs = malloc(count * sizeof(GridChunkRef));
+    RenderLayer* layers = malloc(count * sizeof(RenderLayer));
+
+    // skip tiles that already hold a building, or that appear twice in the batch
+    GridEntry* batch_tiles = NULL;
+    int placed = 0;
+    for (int i = 0; i < count; i++) {
+        const BeltPlacement* p = &placements[i];
+        uint64_t key = ((uint64_t)(uint32_t)world_to_tile(p->x) << 32) | (uint32_t)world_to_tile(p->y);
+        if (does_exist_in_grid(state, p->x, p->y) || hmgeti(batch_tiles, key) >= 0) {
+            continue;
         }
-        else if (dir == conv->dir) {
-            // leave early
-            printf("same dir leaving early\n");
+        hmput(batch_tiles, key, 0);
+
+        const AnimationClip* clip = &anim_set->clips[dir_clips[p->dir]];
+        int row = clip->row >= 0 ? clip->row : 0;
+
+        positions[placed] = (Position){ p->x, p->y };
+        set_refs[placed] = (AnimationSetRef){ set };
+        shader_anims[placed] = (ShaderAnimation){ clip->shader_clip };
+        sprites[placed] = (Sprite){
+            .texture = clip->texture,
+            .src_x = clip->atlas_x,
+            .src_y = clip->atlas_y + row * loaded->height,
+            .src_w = loaded->width,
+            .src_h = loaded->height,
+            .scale_x = loaded->scale_x,
+            .scale_y = loaded->scale_y,
+            .rotation = 0,
+            .palette = palette
+        };
+        directions[placed] = DIR_RIGHT;
+        velocities[placed] = (Velocity){0, 0};
+        conveyors[placed] = (Conveyor){ .dir = p->dir, .in_dir = p->dir, .shape = p->dir };
+        chunk_refs[placed] = (GridChunkRef){ world_to_chunk(p->x), world_to_chunk(p->y) };
+        layers[placed] = (RenderLayer){ RENDER_LAYER_BELTS };
+        placed++;
+    }
+    hmfree(batch_tiles);
+
+    if (placed > 0) {
+        void* data[] = { positions, set_refs, shader_anims, sprites, directions, velocities, conveyors, chunk_refs, layers };
+        const ecs_entity_t* entities = ecs_bulk_init(state->ecs, &(ecs_bulk_desc_t) {
+            .count = placed,
+            .ids = {
+                ecs_id(Position), ecs_id(AnimationSetRef), ecs_id(ShaderAnimation), ecs_id(Sprite),
+                ecs_id(Direction), ecs_id(Velocity), ecs_id(Conveyor), ecs_id(GridChunkRef),
+                ecs_id(RenderLayer)
+            },
+            .data = data
+        });
+
+        // the returned array is only valid until the next ecs operation, so fill the grid first
+        for (int i = 0; i < placed; i++) {
+            insert_entity_to_grid(state, positions[i].x, positions[i].y, entities[i]);
+            grid_chunk_add(state, chunk_refs[i].chunk_x, chunk_refs[i].chunk_y, entities[i]);
+            iso_render_track(state, entities[i]);
         }
-        else if (dir == DIR_RIGHT && conv->dir == DIR_LEFT) {
-            printf("found a dir left, while im facing dir_right, so place as normal\n");
+
+        // shared neighbours end up in the dirty set once, however many belts of the batch touch them
+        for (int i = 0; i < placed; i++) {
+            belt_autotile_mark_dirty(state, world_to_tile(positions[i].x), world_to_tile(positions[i].y));
         }
-        else if (dir == DIR_RIGHT && conv->dir == DIR_DOWN) {
-            // now we can set the dir of the next belt to right_down
-            conv->dir = DIR_DOWN_RIGHT;
-            set_sprite_animation(state->ecs, ent, "down_right");
+    }
+
+    free(positions);
+    free(set_refs);
+    free(shader_anims);
+    free(sprites);
+    free(directions);
+    free(velocities);
+    free(conveyors);
+    free(chunk_refs);
+    free(layers);
+    return placed;
+}
+
+int entity_factory_remove_buildings(AppState* state, const Position* positions, int count) {
+    int removed = 0;
+
+    // deletes are queued and applied together, so flecs moves each table once
+    ecs_defer_begin(state->ecs);
+    for (int i = 0; i < count; i++) {
+        ecs_entity_t e = get_entity_at_grid_position(state, positions[i].x, positions[i].y);
+        if (e == 0) {
+            continue;
         }
-        else if (dir == DIR_RIGHT && conv->dir == DIR_UP) {
-            // now we can set the dir of the next belt to right_down
-            // need to get the animation for this one, its WEST->NORTH
-            conv->dir = DIR_UP_LEFT;
-            set_sprite_animation(state->ecs, ent, "up_left");
+
+        // items riding the belt go with it
+        const Conveyor* conv = ecs_get(state->ecs, e, Conveyor);
+        if (conv) {
+            for (int lane = 0; lane < CONVEYOR_LANES; lane++) {
+                for (int j = 0; j < conv->lane_item_count[lane]; j++) {
+                    if (conv->lane_items[lane][j] != 0) {
+                        ecs_delete(state->ecs, conv->lane_items[lane][j]);
+                    }
+                }
+            }
         }
+
+        ecs_delete(state->ecs, e);
+        delete_entity_from_grid(state, positions[i].x, positions[i].y, e);
+        belt_autotile_mark_dirty(state, world_to_tile(positions[i].x), world_to_tile(positions[i].y));
+        removed++;
     }
+    ecs_defer_end(state->ecs);
 
-    switch (dir) {
-        case DIR_RIGHT:
-            set_sprite_animation(state->ecs, belt, "right");
-            break;
-        case DIR_UP:
-            set_sprite_animation(state->ecs, belt, "up");
-            break;
-        case DIR_DOWN:
-            set_sprite_animation(state->ecs, belt, "down");
-            break;
-        case DIR_LEFT:
-            set_sprite_animation(state->ecs, belt, "left");
-            break;
-        case DIR_DOWN_RIGHT:
-            set_sprite_animation(state->ecs, belt, "down_right");
-            break;
-        case DIR_DOWN_LEFT:
-            set_sprite_animation(state->ecs, belt, "down_left");
-            break;
-        case DIR_UP_RIGHT:
-            set_sprite_animation(state->ecs, belt, "up_right");
-            break;
-        case DIR_UP_LEFT:
-            set_sprite_animation(state->ecs, belt, "up_left");
-            break;
-        default:
-            break;
+    return removed;
+}
+
+int entity_factory_remove_area(AppState* state, float x0, float y0, float x1, float y1) {
+    Position* positions = NULL;
+    for (int ty = world_to_tile(y0); ty <= world_to_tile(y1); ty++) {
+        for (int tx = world_to_tile(x0); tx <= world_to_tile(x1); tx++) {
+            float wx = (float)(tx * TILE_SIZE);
+            float wy = (float)(ty * TILE_SIZE);
+            if (does_exist_in_grid(state, wx, wy)) {
+                arrput(positions, ((Position){ wx, wy }));
+            }
+        }
     }
-    
-    insert_entity_to_grid(state, x, y, belt);
-    return belt;
+
+    int removed = entity_factory_remove_buildings(state, positions, (int)arrlen(positions));
+    arrfree(positions);
+    return removed;
 }
 
 void entity_factory_spawn_conveyor_item(AppState* state, ecs_entity_t conveyor, Lane lane) {
@@ -202,6 +386,6 @@ void entity_factory_spawn_conveyor_item(AppState* state, ecs_entity_t conveyor,
             break;
     }
     
-    ecs_entity_t entity = entity_factory_spawn_sprite(state, "iron", start_x, start_y);
+    ecs_entity_t entity = spawn_sprite(state, "iron", start_x, start_y, (RenderLayer){ RENDER_LAYER_ITEMS });
     conveyor_add_item(state->ecs, conveyor, lane, entity);
 }
\ No newline at end of file
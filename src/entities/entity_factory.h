@@ -11,8 +11,23 @@
 #include "common.h"
 #include "systems/conveyor_system.h"
 #include "systems/render_system.h"
+#include "systems/belt_autotile_system.h"
 
+// builds state->animation_sets and their graphs from the loaded atlas, once before anything
+// is spawned
+void entity_factory_load_animation_sets(AppState* state);
+void entity_factory_free_animation_sets(AppState* state);
 ecs_entity_t entity_factory_spawn_sprite(AppState* state, const char* sprite_name, float x, float y);
+typedef struct {
+    float x, y;
+    Direction dir;
+} BeltPlacement;
+
+const char* belt_animation_name(Direction dir);
 ecs_entity_t entity_factory_spawn_belt(AppState* state, float x, float y, Direction dir);
+// batch versions for blueprints / area clears, both return how many tiles changed
+int entity_factory_spawn_belts(AppState* state, const BeltPlacement* placements, int count);
+int entity_factory_remove_buildings(AppState* state, const Position* positions, int count);
+int entity_factory_remove_area(AppState* state, float x0, float y0, float x1, float y1);
 void entity_factory_spawn_conveyor_item(AppState* state, ecs_entity_t conveyor, Lane lane);
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <unistd.h> 
 #include <math.h>
 #include "font.shader.glsl.h"
+#include "systems/render_stats.h"
 
 static bool generate_font_atlas(font_t* font) {
     font->atlas_width = 512;
@@ -181,10 +182,10 @@ void text_renderer_begin(text_renderer_t* renderer) {
     (void)renderer;
 }
 
-void text_renderer_draw_text(text_renderer_t* renderer, int font_id, const char* text, 
-                            float x, float y, float scale, float color[4], text_anchor_t anchor) {
+int text_renderer_layout_text(text_renderer_t* renderer, int font_id, const char* text, float x, float y,
+                              float scale, text_anchor_t anchor, text_glyph_t* out, int max_glyphs) {
     if (font_id < 0 || font_id >= renderer->font_count) {
-        return;
+        return 0;
     }
     
     font_t* font = &renderer->fonts[font_id];
@@ -238,13 +239,8 @@ void text_renderer_draw_text(text_renderer_t* renderer, int font_id, const char*
     float cursor_x = draw_x;
     float cursor_y = draw_y;
     
-    sgp_set_pipeline(renderer->text_pipeline);
-    sgp_set_color(color[0], color[1], color[2], color[3]);
-    sgp_set_image(0, font->atlas_texture);
-    sgp_set_sampler(0, renderer->sampler);
-    sgp_set_blend_mode(SGP_BLENDMODE_BLEND);
-    
-    for (const char* p = text; *p; p++) {
+    int glyphs = 0;
+    for (const char* p = text; *p && glyphs < max_glyphs; p++) {
         char c = *p;
         
         if (c == '\n') {
@@ -281,11 +277,31 @@ void text_renderer_draw_text(text_renderer_t* renderer, int font_id, const char*
             .h = glyph->tex_h * font->atlas_height
         };
         
-        sgp_draw_textured_rect(0, dest_rect, src_rect);
+        out[glyphs++] = (text_glyph_t) { dest_rect, src_rect };
         
         cursor_x += glyph->advance_x * scale;
     }
-    
+    return glyphs;
+}
+
+void text_renderer_draw_glyphs(text_renderer_t* renderer, int font_id, const text_glyph_t* glyphs, int count,
+                               const float color[4]) {
+    if (font_id < 0 || font_id >= renderer->font_count || count <= 0) {
+        return;
+    }
+    font_t* font = &renderer->fonts[font_id];
+    count = renderer_sgp_room(count, 6, 1);
+
+    sgp_set_pipeline(renderer->text_pipeline);
+    sgp_set_color(color[0], color[1], color[2], color[3]);
+    sgp_set_image(0, font->atlas_texture);
+    sgp_set_sampler(0, renderer->sampler);
+    sgp_set_blend_mode(SGP_BLENDMODE_BLEND);
+
+    for (int i = 0; i < count; i++) {
+        sgp_draw_textured_rect(0, glyphs[i].dst, glyphs[i].src);
+    }
+
     sgp_reset_pipeline();
     sgp_reset_sampler(0);
     sgp_reset_image(0);
@@ -293,6 +309,13 @@ void text_renderer_draw_text(text_renderer_t* renderer, int font_id, const char*
     sgp_reset_color();
 }
 
+void text_renderer_draw_text(text_renderer_t* renderer, int font_id, const char* text, 
+                            float x, float y, float scale, float color[4], text_anchor_t anchor) {
+    text_glyph_t glyphs[TEXT_MAX_GLYPHS];
+    int count = text_renderer_layout_text(renderer, font_id, text, x, y, scale, anchor, glyphs, TEXT_MAX_GLYPHS);
+    text_renderer_draw_glyphs(renderer, font_id, glyphs, count, color);
+}
+
 void text_renderer_render(text_renderer_t* renderer, int width, int height) {
     (void)renderer;
     (void)width;
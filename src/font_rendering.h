@@ -37,6 +37,14 @@ typedef struct {
     sg_pipeline text_pipeline;
 } text_renderer_t;
 
+// a laid out glyph, where it goes on screen and where it is in the font atlas
+typedef struct {
+    sgp_rect dst;
+    sgp_rect src;
+} text_glyph_t;
+
+#define TEXT_MAX_GLYPHS 512  // per draw_text call
+
 typedef enum text_anchor {
     TEXT_ANCHOR_TOP_LEFT,
     TEXT_ANCHOR_TOP_CENTER,
@@ -57,6 +65,12 @@ void text_renderer_begin(text_renderer_t* renderer);
 void text_renderer_draw_text(text_renderer_t* renderer, int font_id, const char* text,
                             float x, float y, float scale, float color[4], text_anchor_t anchor);
 void text_renderer_render(text_renderer_t* renderer, int width, int height);
+// places the glyphs of text without drawing them, for text that is drawn many times.
+// writes at most max_glyphs, returns how many were written
+int text_renderer_layout_text(text_renderer_t* renderer, int font_id, const char* text, float x, float y,
+                              float scale, text_anchor_t anchor, text_glyph_t* out, int max_glyphs);
+void text_renderer_draw_glyphs(text_renderer_t* renderer, int font_id, const text_glyph_t* glyphs, int count,
+                               const float color[4]);
 void text_renderer_get_text_size(text_renderer_t* renderer, int font_id, const char* text,
                                  float scale, float* width, float* height);
 
@@ -10,11 +10,16 @@
 #include "font_rendering.h"
 #include "shader.glsl.h"
 #include "util/map_loader.h"
+#include "util/camera.h"
 #include "entities/entity_factory.h"
 #include "systems/animation_system.h"
 #include "systems/render_system.h"
 #include "systems/conveyor_system.h"
 #include "systems/input_system.h"
+#include "systems/build_system.h"
+#include "systems/belt_autotile_system.h"
+#include "systems/render_thread.h"
+#include "systems/minimap.h"
 
 
 #include "components/animation_graph.h"
@@ -59,10 +64,19 @@ void app_wait_for_next_frame(void *appstate) {
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     (void)argc;
     (void)argv;
+#ifdef RENDER_HEADLESS
+    headless_parse_args(argc, argv);
+    // golden images have to come out the same every run
+    srand(0);
+#else
     srand(time(NULL));
+#endif
 
     AppState* state = SDL_calloc(1, sizeof(AppState));
     *appstate = state;
+#ifdef RENDER_HEADLESS
+    state->capture_mode = headless_options.record;
+#endif
 
     // Initialise ecs_world
     state->ecs = ecs_init();
@@ -79,7 +93,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
 
         // register systems
     ECS_SYSTEM(state->ecs, UpdateDirectionSystem, EcsOnUpdate, Velocity, Direction);
-    ECS_SYSTEM(state->ecs, AnimationGraphSystem, EcsOnUpdate, AnimationSet, AnimationState, AnimationGraphComponent);
+    ECS_SYSTEM(state->ecs, AnimationGraphSystem, EcsOnUpdate, AnimationSetRef, AnimationState, AnimationGraphComponent, ?Velocity);
     conveyor_system_init(state->ecs);
     input_system_init(state);
 
@@ -92,6 +106,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     }
 
     printf("window first");
+    camera_init(&state->camera, state->width, state->height);
 
     // Initialize renderer
     if (!renderer_initialize(state)) {
@@ -105,6 +120,18 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     // Initialise the sprite system
     sprite_atlas_init(&state->sprite_atlas);
     sprite_atlas_load(&state->sprite_atlas, "assets/sprites/sprite_definitions.json");
+    sprite_batch_register_clips(&state->renderer.sprites, &state->sprite_atlas);
+    sprite_batch_register_palette(&state->renderer.sprites, &state->sprite_atlas);
+    entity_factory_load_animation_sets(state);
+    // the map decides the size of the grid
+    load_map(state, "assets/map/isometric-sandbox-map.tmj");
+    // needs the map, and registers the tilesets with the sprite batch
+    iso_render_init(state);
+    // pathfinding has to exist before anything is placed on the grid
+    pathfinding_init(&state->pathfinding, state->map.map_width, state->map.map_height);
+    // covers the same grid as pathfinding
+    minimap_init(&state->minimap, state->pathfinding.width, state->pathfinding.height);
+    particles_init(&state->particles);
     // spawn a player entity
     player = entity_factory_spawn_sprite(state, "player", 200, 200);
     // ecs_entity_t belt = entity_factory_spawn_belt(state, 300, 300, DIR_RIGHT);
@@ -130,8 +157,6 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     ecs_entity_t belt5 = entity_factory_spawn_belt(state, 332, 332, DIR_RIGHT);
     ecs_entity_t belt6 = entity_factory_spawn_belt(state, 364, 364, DIR_DOWN);
 
-    // load the map
-    load_map(state, "");
     // Initialise the text renderer
     text_renderer_init(&renderer, 1000);
     state->renderer.text_renderer = &renderer;
@@ -142,6 +167,16 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     // Initialize FPS counter
     fps_counter.last_fps_update = SDL_GetTicks();
     snprintf(fps_counter.fps_text, sizeof(fps_counter.fps_text), "FPS: 0.0");
+    state->fps_label = ui_label(&state->ui, TEXT_ANCHOR_TOP_LEFT, 0, 0, state->font[0], (float[4])SG_WHITE,
+                                fps_counter.fps_text);
+    ui_label(&state->ui, TEXT_ANCHOR_TOP_CENTER, 0, 0, state->font[1], (float[4])SG_WHITE, "WORK IN PROGRESS");
+
+    // one core for the simulation, one for the render thread, the rest help with extraction
+    job_pool_init(&state->jobs, SDL_GetNumLogicalCPUCores() - 2);
+
+    // everything that makes gpu resources at startup is done, the render thread takes the
+    // context from here on
+    render_thread_start(state);
 
     return 0;
 }
@@ -153,6 +188,10 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     state->last_tick = state->current_tick;
     state->current_tick = SDL_GetTicks();
     state->delta_time = (state->current_tick - state->last_tick) / 1000.0f;
+#ifdef RENDER_HEADLESS
+    // fixed steps so a given frame always shows the same thing
+    state->delta_time = 1.0f / 60.0f;
+#endif
 
     state->ecs_accumulator += state->delta_time;
 
@@ -169,17 +208,31 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     Position* pos = ecs_get_mut(state->ecs, player, Position);
     pos->x += vel->x * state->delta_time * 60;  // Scale by delta time
     pos->y += vel->y * state->delta_time * 60;  // Scale by delta time
-    
+
+    // apply queued build commands in one batch before the systems run
+    build_system_apply(state);
+    belt_autotile_resolve(state);
+
     ecs_progress(state->ecs, state->delta_time);
 
     update_animations(state, state->delta_time);
+    particles_update(state, state->delta_time);
     // Update FPS counter
     fps_counter_update(state);
 
-    // draw the frame
+    // copy out what is visible and hand it to the render thread, which draws it while the
+    // next frame is simulated
     renderer_draw_frame(state);
 
+#ifdef RENDER_HEADLESS
+    // benchmarks run flat out. the last frame is still drawn when the render thread stops
+    static int frames = 0;
+    if (headless_options.frames > 0 && ++frames >= headless_options.frames) {
+        return SDL_APP_SUCCESS;
+    }
+#else
     app_wait_for_next_frame(appstate);
+#endif
     return SDL_APP_CONTINUE;
 }
 
@@ -187,7 +240,11 @@ void do_resize(void* appstate) {
     AppState* state = (AppState*) appstate;
     int width, height;
     SDL_GetWindowSize(state->window, &width, &height);
-    renderer_resize(state, width, height);
+    // the backbuffer is resized by the thread that draws, when a packet of the new size arrives
+    state->width = width;
+    state->height = height;
+    SDL_GetWindowSizeInPixels(state->window, &state->pixel_width, &state->pixel_height);
+    camera_set_viewport(&state->camera, width, height);
 }
 
 SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
@@ -195,6 +252,7 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
 
     switch(event->type) {
         case SDL_EVENT_WINDOW_RESIZED:
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
             do_resize(appstate); 
             break;
         default:
@@ -210,6 +268,20 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result)
     AppState* state = (AppState*) appstate;
     // Cleanup
     printf("Shutting down application...\n");
+    render_thread_stop(state);
+    frame_capture_stop(&state->renderer.capture);
+    job_pool_shutdown(&state->jobs);
+    minimap_shutdown(&state->minimap);
+    iso_render_shutdown(state);
+    pathfinding_shutdown(&state->pathfinding);
+    map_free(&state->map);
+    sprite_batch_shutdown(&state->renderer.sprites);
+    particles_render_shutdown(state);
+    particles_shutdown(&state->particles);
+    scene_target_destroy(&state->renderer.scene);
+    ui_cache_destroy(&state->renderer.ui);
+    ui_shutdown(&state->ui);
+    entity_factory_free_animation_sets(state);
     renderer_shutdown(state);
     window_shutdown(state->window);
 
@@ -1,20 +1,109 @@
 @module sgp
-@vs vs
-layout(location=0) in vec4 coord;  // position in xy, texcoord in zw
-layout(location=1) in vec4 color;
-layout(location=0) out vec4 v_color;
+
+// instanced sprites. one record per sprite, the quad is expanded here from the vertex index
+@vs sprite_vs
+layout(binding=0) uniform sprite_vs_params {
+    vec4 view;       // visible world rect: x0, y0, width, height
+    vec4 time;       // x: seconds, wrapped
+    vec4 clips[64];  // looping clips: frame count, frame time, uv step per frame (u, v)
+};
+
+layout(location=0) in vec2 inst_pos;   // top-left in world space
+layout(location=1) in vec2 inst_size;  // scaled size in world pixels
+layout(location=2) in vec4 inst_uv;    // u0, v0, u1, v1 in the atlas page
+layout(location=3) in float inst_rot;  // radians around the top-left corner
+layout(location=4) in vec4 inst_tint;
+layout(location=5) in vec4 inst_anim;  // clip in the table above (0 = static), frame offset,
+                                       // palette row + 1 (0 = not indexed)
+
+layout(location=0) out vec2 uv;
+layout(location=1) out vec4 tint;
+layout(location=2) flat out float palette;
+
 void main() {
-    gl_Position = vec4(coord.xy, 0.0, 1.0);
-    v_color = color;
+    const vec2 corners[6] = vec2[6](
+        vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+        vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+    );
+    vec2 corner = corners[gl_VertexIndex];
+    vec2 local = corner * inst_size;
+    float s = sin(inst_rot);
+    float c = cos(inst_rot);
+    vec2 world = inst_pos + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    vec2 ndc = (world - view.xy) / view.zw * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+    // cosmetic loops pick their frame here, the cpu never touches them after spawning
+    vec4 frame_uv = inst_uv;
+    int clip = int(inst_anim.x);
+    if (clip > 0) {
+        vec4 c = clips[clip - 1];
+        float frame = mod(floor(time.x / c.y) + inst_anim.y, c.x);
+        frame_uv += c.zwzw * frame;
+    }
+    uv = mix(frame_uv.xy, frame_uv.zw, corner);
+    tint = inst_tint;
+    palette = inst_anim.z;
 }
 @end
 
-@fs fs
-layout(location=0) in vec4 v_color;
+@fs sprite_fs
+layout(binding=0) uniform texture2D sprite_tex;
+layout(binding=1) uniform texture2D sprite_palette;  // 256 colours per row
+layout(binding=0) uniform sampler sprite_smp;
+layout(location=0) in vec2 uv;
+layout(location=1) in vec4 tint;
+layout(location=2) flat in float palette;
 layout(location=0) out vec4 frag_color;
 
 void main() {
-    frag_color = v_color;
+    vec4 texel = texture(sampler2D(sprite_tex, sprite_smp), uv);
+    // indexed pages hold a palette index in red, the same for the whole sprite
+    if (palette > 0.0) {
+        int index = int(texel.r * 255.0 + 0.5);
+        texel = texelFetch(sampler2D(sprite_palette, sprite_smp), ivec2(index, int(palette) - 1), 0);
+    }
+    frag_color = texel * tint;
 }
 @end
-@program program vs fs
\ No newline at end of file
+
+@program sprite sprite_vs sprite_fs
+
+// particles, one instance each drawn as a soft round blob of its colour
+@vs particle_vs
+layout(binding=0) uniform particle_vs_params {
+    vec4 view;  // visible world rect: x0, y0, width, height
+};
+
+layout(location=0) in vec3 part_pos;     // centre in world space, size
+layout(location=1) in vec4 part_colour;
+
+layout(location=0) out vec2 local;
+layout(location=1) out vec4 colour;
+
+void main() {
+    const vec2 corners[6] = vec2[6](
+        vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+        vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0)
+    );
+    local = corners[gl_VertexIndex];
+    vec2 world = part_pos.xy + local * part_pos.z * 0.5;
+
+    vec2 ndc = (world - view.xy) / view.zw * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+    colour = part_colour;
+}
+@end
+
+@fs particle_fs
+layout(location=0) in vec2 local;
+layout(location=1) in vec4 colour;
+layout(location=0) out vec4 frag_color;
+
+void main() {
+    float fade = clamp(1.0 - dot(local, local), 0.0, 1.0);
+    frag_color = vec4(colour.rgb, colour.a * fade);
+}
+@end
+
+@program particle particle_vs particle_fs
@@ -5,51 +5,48 @@
 
 #include <math.h>
 void AnimationGraphSystem(ecs_iter_t *it) {
-    AnimationSet *anim_set = ecs_field(it, AnimationSet, 0);
+    AppState *state = ecs_get_ctx(it->world);
+    AnimationSetRef *set_ref = ecs_field(it, AnimationSetRef, 0);
     AnimationState *anim_state = ecs_field(it, AnimationState, 1);
     AnimationGraphComponent *graph_comp = ecs_field(it, AnimationGraphComponent, 2);
+    const Velocity *vel = ecs_field_is_set(it, 3) ? ecs_field(it, Velocity, 3) : NULL;
+    uint32_t results[ANIMATION_CONDITION_BATCH];
    
-    for (int i = 0; i < it->count; i++) {
-        if (!graph_comp[i].graph) continue;
-       
-        AnimationGraph *graph = graph_comp[i].graph;
-        
-        // Get current animation name from the clip index
-        const char *current = anim_set[i].clip_names[anim_state[i].current_clip];
-        const AnimationClip *current_clip = &anim_set[i].clips[anim_state[i].current_clip];
-       
-        AnimationTransition *best = NULL;
-        int best_priority = -1;
-       
-        for (int t = 0; t < graph->transition_count; t++) {
-            AnimationTransition *trans = &graph->transitions[t];
-           
-            // Check if transition applies to current state
-            bool from_matches = (strcmp(trans->from, "*") == 0) ||
-                               (strcmp(trans->from, current) == 0);
-            if (!from_matches) continue;
-           
-            bool should_transition = false;
+    for (int start = 0; start < it->count; start += ANIMATION_CONDITION_BATCH) {
+        int count = it->count - start;
+        if (count > ANIMATION_CONDITION_BATCH) count = ANIMATION_CONDITION_BATCH;
+
+        // every condition once over the batch's columns, not once per transition per entity
+        AnimationColumns columns = { .velocity = vel ? vel + start : NULL, .count = count };
+        animation_conditions_evaluate(&columns, results);
+
+        for (int j = 0; j < count; j++) {
+            int i = start + j;
+            const AnimationGraph *graph = graph_comp[i].graph;
+            if (!graph) continue;
+            
+            int current = anim_state[i].current_clip;
+            const AnimationClip *current_clip = &state->animation_sets[set_ref[i].set].clips[current];
+            if (!current_clip->loop && anim_state[i].current_frame == current_clip->frame_count - 1) {
+                results[j] |= 1u << ANIMATION_CONDITION_COMPLETE;
+            }
            
-            // NULL condition = animation_complete
-            if (trans->condition == NULL) {
-                if (!current_clip->loop &&
-                    anim_state[i].current_frame == current_clip->frame_count - 1) {
-                    should_transition = true;
+            // only the current state's transitions, best first, so the first that fires wins.
+            // negative priorities never fire
+            int best = -1;
+            for (int t = graph->first[current]; t < graph->first[current + 1]; t++) {
+                const AnimationTransition *trans = &graph->transitions[t];
+                if (trans->priority < 0) break;
+                if (results[j] & trans->condition) {
+                    best = trans->to;
+                    break;
                 }
-            } else {
-                should_transition = trans->condition(it->world, it->entities[i]);
             }
            
-            if (should_transition && trans->priority > best_priority) {
-                best = trans;
-                best_priority = trans->priority;
+            if (best >= 0 && best != current) {
+                set_sprite_clip(it->world, it->entities[i], best);
             }
         }
-       
-        if (best && strcmp(best->to, current) != 0) {
-            set_sprite_animation(it->world, it->entities[i], best->to);
-        }
     }
 }
 
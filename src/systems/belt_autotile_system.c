@@ -0,0 +1,156 @@
+#include "belt_autotile_system.h"
+#include "entities/entity_factory.h"
+#include "util/grid_helper.h"
+
+static inline uint64_t tile_key(int x, int y) {
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+static inline int key_x(uint64_t key) { return (int)(uint32_t)(key >> 32); }
+static inline int key_y(uint64_t key) { return (int)(uint32_t)key; }
+
+static const int cardinals[4] = { DIR_UP, DIR_RIGHT, DIR_DOWN, DIR_LEFT };
+
+static int dir_dx(Direction dir) {
+    return dir == DIR_RIGHT ? 1 : (dir == DIR_LEFT ? -1 : 0);
+}
+
+static int dir_dy(Direction dir) {
+    return dir == DIR_DOWN ? 1 : (dir == DIR_UP ? -1 : 0);
+}
+
+static Direction opposite(Direction dir) {
+    switch (dir) {
+        case DIR_UP: return DIR_DOWN;
+        case DIR_DOWN: return DIR_UP;
+        case DIR_LEFT: return DIR_RIGHT;
+        default: return DIR_LEFT;
+    }
+}
+
+// corner sprites are named after the two tile edges they join:
+// west + south = down_right, west + north = up_left, east + north = up_right, east + south = down_left
+static Direction corner_shape(Direction in_side, Direction out_side) {
+    bool west = in_side == DIR_LEFT || out_side == DIR_LEFT;
+    bool north = in_side == DIR_UP || out_side == DIR_UP;
+    if (west) return north ? DIR_UP_LEFT : DIR_DOWN_RIGHT;
+    return north ? DIR_UP_RIGHT : DIR_DOWN_LEFT;
+}
+
+// which lane of a belt flowing in flow sits against the given edge of its tile.
+// matches the lane offsets in update_conveyor_item_sprite
+static Lane lane_on_side(Direction flow, Direction side) {
+    switch (flow) {
+        case DIR_UP:
+        case DIR_DOWN:
+            return side == DIR_LEFT ? LANE_LEFT : LANE_RIGHT;
+        case DIR_RIGHT:
+            return side == DIR_DOWN ? LANE_LEFT : LANE_RIGHT;
+        default:
+            return side == DIR_UP ? LANE_LEFT : LANE_RIGHT;
+    }
+}
+
+static ecs_entity_t belt_at(AppState* state, int tile_x, int tile_y, Conveyor** conv) {
+    ecs_entity_t e = get_entity_at_grid_position(state, tile_x * TILE_SIZE, tile_y * TILE_SIZE);
+    *conv = e != 0 ? ecs_get_mut(state->ecs, e, Conveyor) : NULL;
+    return *conv ? e : 0;
+}
+
+void belt_autotile_mark_dirty(AppState* state, int tile_x, int tile_y) {
+    hmput(state->dirty_belts, tile_key(tile_x, tile_y), true);
+    for (int i = 0; i < 4; i++) {
+        hmput(state->dirty_belts, tile_key(tile_x + dir_dx(cardinals[i]), tile_y + dir_dy(cardinals[i])), true);
+    }
+}
+
+// straight if fed from behind, a corner if fed from exactly one side, straight otherwise.
+// returns true when the shape changed
+static bool resolve_shape(AppState* state, ecs_entity_t belt, Conveyor* conv, int tx, int ty) {
+    Direction in_dir = conv->dir;
+    Conveyor* feeder;
+
+    if (!belt_at(state, tx - dir_dx(conv->dir), ty - dir_dy(conv->dir), &feeder) || feeder->dir != conv->dir) {
+        int side_feeds = 0;
+        Direction side_flow = conv->dir;
+        for (int i = 0; i < 4; i++) {
+            Direction side = cardinals[i];
+            if (side == conv->dir || side == opposite(conv->dir)) {
+                continue;
+            }
+            if (belt_at(state, tx + dir_dx(side), ty + dir_dy(side), &feeder) && feeder->dir == opposite(side)) {
+                side_flow = feeder->dir;
+                side_feeds++;
+            }
+        }
+        if (side_feeds == 1) {
+            in_dir = side_flow;
+        }
+    }
+
+    Direction shape = in_dir == conv->dir ? conv->dir : corner_shape(opposite(in_dir), conv->dir);
+    bool changed = in_dir != conv->in_dir || shape != conv->shape;
+    conv->in_dir = in_dir;
+    conv->isCorner = in_dir != conv->dir;
+    if (shape != conv->shape) {
+        conv->shape = shape;
+        set_sprite_animation(state->ecs, belt, belt_animation_name(shape));
+    }
+    return changed;
+}
+
+// successor and lane mapping, using the already resolved shape of the successor
+static void resolve_link(AppState* state, Conveyor* conv, int tx, int ty) {
+    Conveyor* succ;
+    ecs_entity_t next = belt_at(state, tx + dir_dx(conv->dir), ty + dir_dy(conv->dir), &succ);
+
+    conv->next = 0;
+    conv->next_lane[LANE_LEFT] = LANE_LEFT;
+    conv->next_lane[LANE_RIGHT] = LANE_RIGHT;
+    if (next == 0 || succ->dir == opposite(conv->dir)) {
+        return;
+    }
+
+    conv->next = next;
+    if (succ->in_dir != conv->dir) {
+        // side loading, everything lands on the lane nearest to us
+        Lane lane = lane_on_side(succ->dir, opposite(conv->dir));
+        conv->next_lane[LANE_LEFT] = lane;
+        conv->next_lane[LANE_RIGHT] = lane;
+    }
+}
+
+void belt_autotile_resolve(AppState* state) {
+    int count = (int)hmlen(state->dirty_belts);
+    if (count == 0) {
+        return;
+    }
+
+    // shapes first, so every link below sees final successor shapes. a shape change also
+    // changes how the neighbours feeding it map their lanes, so those get relinked too
+    TileFlag* relink = NULL;
+    for (int i = 0; i < count; i++) {
+        uint64_t key = state->dirty_belts[i].key;
+        int tx = key_x(key), ty = key_y(key);
+        Conveyor* conv;
+        ecs_entity_t belt = belt_at(state, tx, ty, &conv);
+
+        hmput(relink, key, true);
+        if (belt && resolve_shape(state, belt, conv, tx, ty)) {
+            for (int d = 0; d < 4; d++) {
+                hmput(relink, tile_key(tx + dir_dx(cardinals[d]), ty + dir_dy(cardinals[d])), true);
+            }
+        }
+    }
+
+    for (int i = 0; i < hmlen(relink); i++) {
+        int tx = key_x(relink[i].key), ty = key_y(relink[i].key);
+        Conveyor* conv;
+        if (belt_at(state, tx, ty, &conv)) {
+            resolve_link(state, conv, tx, ty);
+        }
+    }
+
+    hmfree(relink);
+    hmfree(state->dirty_belts);
+}
@@ -0,0 +1,13 @@
+#ifndef BELT_AUTOTILE_SYSTEM_H
+#define BELT_AUTOTILE_SYSTEM_H
+
+#include "common.h"
+#include "components/conveyor.h"
+
+// a belt's shape depends on its four neighbours. any change to a tile marks it and its
+// neighbours dirty, and belt_autotile_resolve works through the dirty set once per tick,
+// so a whole drag or blueprint only re-evaluates each affected tile once.
+void belt_autotile_mark_dirty(AppState* state, int tile_x, int tile_y);
+void belt_autotile_resolve(AppState* state);
+
+#endif
@@ -0,0 +1,105 @@
+#include "build_system.h"
+#include <stdio.h>
+#include "entities/entity_factory.h"
+#include "util/grid_helper.h"
+#include "systems/belt_autotile_system.h"
+#include "systems/particles.h"
+
+#define BUILD_SMOKE_PARTICLES 12
+#define BUILD_SPARK_PARTICLES 24
+
+void build_queue_place_belt(Input* input, int tile_x, int tile_y, Direction dir) {
+    arrput(input->commands, ((BuildCommand) {
+        .type = BUILD_PLACE_BELT,
+        .tile_x = tile_x,
+        .tile_y = tile_y,
+        .dir = dir
+    }));
+}
+
+void build_queue_remove(Input* input, int tile_x, int tile_y) {
+    arrput(input->commands, ((BuildCommand) {
+        .type = BUILD_REMOVE,
+        .tile_x = tile_x,
+        .tile_y = tile_y
+    }));
+}
+
+static inline uint64_t tile_key(int x, int y) {
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+// turning a belt that already exists (the corner of a drag that changed direction)
+static void rotate_belt(AppState* state, ecs_entity_t belt, Direction dir) {
+    Conveyor* conv = ecs_get_mut(state->ecs, belt, Conveyor);
+    if (!conv || conv->dir == dir) {
+        return;
+    }
+    conv->dir = dir;
+
+    const Position* pos = ecs_get(state->ecs, belt, Position);
+    belt_autotile_mark_dirty(state, world_to_tile(pos->x), world_to_tile(pos->y));
+}
+
+void build_system_apply(AppState* state) {
+    Input* input = ecs_get_mut(state->ecs, state->input_component, Input);
+    int count = (int)arrlen(input->commands);
+    if (count == 0) {
+        return;
+    }
+
+    // a fast drag can touch the same tile several times in one tick, only the last command counts
+    struct { uint64_t key; int value; } *last = NULL;
+    for (int i = 0; i < count; i++) {
+        hmput(last, tile_key(input->commands[i].tile_x, input->commands[i].tile_y), i);
+    }
+
+    BeltPlacement* placements = NULL;
+    Position* removals = NULL;
+    for (int i = 0; i < count; i++) {
+        BuildCommand* cmd = &input->commands[i];
+        if (hmget(last, tile_key(cmd->tile_x, cmd->tile_y)) != i) {
+            continue;
+        }
+
+        float x = (float)(cmd->tile_x * TILE_SIZE);
+        float y = (float)(cmd->tile_y * TILE_SIZE);
+        ecs_entity_t existing = get_entity_at_grid_position(state, x, y);
+
+        switch (cmd->type) {
+            case BUILD_PLACE_BELT:
+                if (existing != 0) {
+                    rotate_belt(state, existing, cmd->dir);
+                } else {
+                    arrput(placements, ((BeltPlacement) { x, y, cmd->dir }));
+                }
+                break;
+            case BUILD_REMOVE:
+                if (existing != 0) {
+                    arrput(removals, ((Position) { x, y }));
+                }
+                break;
+        }
+    }
+
+    if (arrlen(removals) > 0) {
+        entity_factory_remove_buildings(state, removals, (int)arrlen(removals));
+    }
+    if (arrlen(placements) > 0) {
+        entity_factory_spawn_belts(state, placements, (int)arrlen(placements));
+    }
+
+    // a puff of smoke where something was torn down, sparks where a belt went in
+    const float half = TILE_SIZE * 0.5f;
+    for (int i = 0; i < arrlen(removals); i++) {
+        particles_emit_at(state, PARTICLE_SMOKE, removals[i].x + half, removals[i].y + half, BUILD_SMOKE_PARTICLES);
+    }
+    for (int i = 0; i < arrlen(placements); i++) {
+        particles_emit_at(state, PARTICLE_SPARK, placements[i].x + half, placements[i].y + half, BUILD_SPARK_PARTICLES);
+    }
+
+    arrfree(placements);
+    arrfree(removals);
+    hmfree(last);
+    arrsetlen(input->commands, 0);
+}
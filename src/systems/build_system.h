@@ -0,0 +1,13 @@
+#ifndef BUILD_SYSTEM_H
+#define BUILD_SYSTEM_H
+
+#include <flecs.h>
+#include "common.h"
+#include "components/input.h"
+
+void build_queue_place_belt(Input* input, int tile_x, int tile_y, Direction dir);
+void build_queue_remove(Input* input, int tile_x, int tile_y);
+// applies everything queued since the last tick as one batch
+void build_system_apply(AppState* state);
+
+#endif
@@ -117,55 +117,14 @@ void update_conveyor_items(ecs_iter_t *it)
         if (item->progress >= 1.0f)
         {
             item->progress = 1.0f;
-            AppState *state = ecs_get_ctx(it->world);
-            
-            const Position *conveyor_pos = ecs_get(it->world, item->conveyor, Position);
-            if (!conveyor_pos)
-                continue;
-
-            // Calculate next position based on direction
-            float next_x = conveyor_pos->x;
-            float next_y = conveyor_pos->y;
-
-            switch (conveyor->dir)
-            {
-                case DIR_RIGHT:
-                    next_x = conveyor_pos->x + TILE_SIZE;
-                    break;
-                case DIR_LEFT:
-                    next_x = conveyor_pos->x - TILE_SIZE;
-                    break;
-                case DIR_UP:
-                    next_y = conveyor_pos->y - TILE_SIZE;
-                    break;
-                case DIR_DOWN:
-                    next_y = conveyor_pos->y + TILE_SIZE;
-                    break;
-            }
 
-            // Get next belt entity at the calculated position
-            ecs_entity_t next_belt = get_entity_at_grid_position(state, next_x, next_y);
-            
-            // Only add transfer if next belt exists AND has a Conveyor component
-            if (next_belt != 0 && ecs_has(it->world, next_belt, Conveyor))
+            // the autotiler already picked the successor and the lane we land on
+            ecs_entity_t next_belt = conveyor->next;
+            if (next_belt != 0 && ecs_is_alive(it->world, next_belt))
             {
-                const Conveyor *next_conveyor = ecs_get(it->world, next_belt, Conveyor);
-
-                // need to calculate target lane
-                // If DIR_RIGHT -> DIR_DOWN target lane is 0 
-                // if DIR_RIGHT -> DIR_UP target lane is 1
-                Lane target_lane = LANE_LEFT;
-                if (conveyor->dir == DIR_RIGHT && next_conveyor->dir == DIR_DOWN) {
-                    target_lane = LANE_LEFT;
-                }
-                else if (conveyor->dir == DIR_RIGHT && next_conveyor->dir == DIR_RIGHT) {
-                    target_lane = item->lane;
-                }
-                else if (conveyor->dir == DIR_LEFT && next_conveyor->dir == DIR_UP) {
-                    target_lane = LANE_RIGHT;
-                }
+                Lane target_lane = conveyor->next_lane[item->lane];
 
-                if (conveyor_can_accept_item(it->world, next_belt, item->lane))
+                if (conveyor_can_accept_item(it->world, next_belt, target_lane))
                 {
                     ecs_set(it->world, e, ConveyorTransfer, {
                         .next_conveyor = next_belt, 
@@ -188,6 +147,9 @@ void update_conveyor_item_sprite(ecs_iter_t *it)
         // Calculate visual position based on current progress
         // (No progress updates here!)
 
+        if (!ecs_is_alive(it->world, item->conveyor))
+            continue;
+
         const Conveyor *conveyor = ecs_get(it->world, item->conveyor, Conveyor);
         const Position *conv_pos = ecs_get(it->world, item->conveyor, Position);
 
@@ -237,6 +199,13 @@ void process_conveyor_transfers(ecs_iter_t *it)
         if (!item || !transfer)
             continue;
 
+        // either belt may have been removed since the transfer was queued
+        if (!ecs_is_alive(it->world, item->conveyor) || !ecs_is_alive(it->world, transfer->next_conveyor))
+        {
+            ecs_remove(it->world, e, ConveyorTransfer);
+            continue;
+        }
+
         // Get old and new conveyors
         Conveyor *old_conv = ecs_get_mut(it->world, item->conveyor, Conveyor);
         Conveyor *new_conv = ecs_get_mut(it->world, transfer->next_conveyor, Conveyor);
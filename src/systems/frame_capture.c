@@ -0,0 +1,273 @@
+#include "frame_capture.h"
+#include <stdlib.h>
+#include <string.h>
+#include "stb_image_write.h"
+
+#ifdef SOKOL_GLCORE
+
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
+static void write_frame(FrameCapture* capture, const CapturedFrame* frame) {
+    char path[512];
+    if (capture->mode == FRAME_CAPTURE_PNG) {
+        snprintf(path, sizeof(path), "%s/frame_%05d.png", capture->directory, frame->frame);
+        // gl rows start at the bottom
+        stbi_flip_vertically_on_write(1);
+        if (!stbi_write_png(path, frame->width, frame->height, 4, frame->pixels, frame->width * 4)) {
+            fprintf(stderr, "Failed to write %s\n", path);
+        }
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/frame_%05d_%dx%d.rgba", capture->directory, frame->frame,
+             frame->width, frame->height);
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return;
+    }
+    size_t row = (size_t)frame->width * 4;
+    for (int y = frame->height - 1; y >= 0; y--) {
+        fwrite(frame->pixels + (size_t)y * row, 1, row, fp);
+    }
+    fclose(fp);
+}
+
+static int encoder_main(void* data) {
+    FrameCapture* capture = (FrameCapture*) data;
+
+    for (;;) {
+        SDL_LockMutex(capture->lock);
+        while (capture->queue_count == 0 && !capture->quit) {
+            SDL_WaitCondition(capture->cond, capture->lock);
+        }
+        if (capture->queue_count == 0) {
+            SDL_UnlockMutex(capture->lock);
+            break;
+        }
+        // the slot stays counted while it's written, so it isn't handed out again
+        CapturedFrame* frame = &capture->queue[capture->queue_head];
+        SDL_UnlockMutex(capture->lock);
+
+        write_frame(capture, frame);
+
+        SDL_LockMutex(capture->lock);
+        capture->queue_head = (capture->queue_head + 1) % FRAME_CAPTURE_QUEUE;
+        capture->queue_count--;
+        capture->written++;
+        SDL_SignalCondition(capture->cond);
+        SDL_UnlockMutex(capture->lock);
+    }
+    return 0;
+}
+
+// the next free queue slot, grown to fit. NULL if the encoder is behind, unless told to wait
+static CapturedFrame* queue_reserve(FrameCapture* capture, int width, int height, bool wait) {
+    SDL_LockMutex(capture->lock);
+    while (wait && capture->queue_count >= FRAME_CAPTURE_QUEUE) {
+        SDL_WaitCondition(capture->cond, capture->lock);
+    }
+    int count = capture->queue_count;
+    int index = (capture->queue_head + count) % FRAME_CAPTURE_QUEUE;
+    SDL_UnlockMutex(capture->lock);
+    if (count >= FRAME_CAPTURE_QUEUE) {
+        return NULL;
+    }
+
+    // only the encoder's slots are touched by the encoder, this one is ours until it's queued
+    CapturedFrame* frame = &capture->queue[index];
+    size_t size = (size_t)width * height * 4;
+    if (frame->capacity < size) {
+        unsigned char* pixels = realloc(frame->pixels, size);
+        if (!pixels) {
+            return NULL;
+        }
+        frame->pixels = pixels;
+        frame->capacity = size;
+    }
+    frame->width = width;
+    frame->height = height;
+    return frame;
+}
+
+static void queue_push(FrameCapture* capture) {
+    SDL_LockMutex(capture->lock);
+    capture->queue_count++;
+    SDL_SignalCondition(capture->cond);
+    SDL_UnlockMutex(capture->lock);
+}
+
+static bool start(FrameCapture* capture, FrameCaptureMode mode) {
+    snprintf(capture->directory, sizeof(capture->directory), "%s/%llu", FRAME_CAPTURE_DIR,
+             (unsigned long long)SDL_GetTicks());
+    if (!SDL_CreateDirectory(capture->directory)) {
+        fprintf(stderr, "Failed to create %s: %s\n", capture->directory, SDL_GetError());
+        return false;
+    }
+
+    capture->lock = SDL_CreateMutex();
+    capture->cond = SDL_CreateCondition();
+    capture->quit = false;
+    capture->queue_head = capture->queue_count = 0;
+    capture->mode = mode;
+    capture->thread = SDL_CreateThread(encoder_main, "frame-capture", capture);
+    if (!capture->thread) {
+        fprintf(stderr, "Failed to start the capture encoder: %s\n", SDL_GetError());
+        SDL_DestroyCondition(capture->cond);
+        SDL_DestroyMutex(capture->lock);
+        capture->mode = FRAME_CAPTURE_OFF;
+        return false;
+    }
+
+    capture->frame = capture->written = capture->dropped = 0;
+    capture->head = 0;
+    printf("Capturing %s frames to %s\n", mode == FRAME_CAPTURE_PNG ? "png" : "raw", capture->directory);
+    return true;
+}
+
+// maps the copy in slot and queues it for the encoder. without wait a copy the gpu hasn't
+// finished is left in flight
+static void collect(FrameCapture* capture, int slot, bool wait) {
+    GLsync fence = (GLsync) capture->fences[slot];
+    if (!fence) {
+        return;
+    }
+    GLenum status = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                     wait ? 1000000000ull : 0);
+    if (status == GL_TIMEOUT_EXPIRED && !wait) {
+        return;
+    }
+    glDeleteSync(fence);
+    capture->fences[slot] = NULL;
+
+    int width = capture->widths[slot];
+    int height = capture->heights[slot];
+    CapturedFrame* frame = status == GL_WAIT_FAILED ? NULL : queue_reserve(capture, width, height, wait);
+    if (!frame) {
+        capture->dropped++;
+        return;
+    }
+
+    size_t size = (size_t)width * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[slot]);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+    if (!pixels) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        capture->dropped++;
+        return;
+    }
+    memcpy(frame->pixels, pixels, size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    frame->frame = capture->frames[slot];
+    queue_push(capture);
+}
+
+// starts copying the frame into slot. returns at once, the gpu does the copy later
+static void copy_frame(FrameCapture* capture, int slot, sg_swapchain swapchain) {
+    int width = swapchain.width;
+    int height = swapchain.height;
+    if (!capture->buffers[slot]) {
+        glGenBuffers(1, &capture->buffers[slot]);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[slot]);
+    if (capture->widths[slot] != width || capture->heights[slot] != height) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 4, NULL, GL_STREAM_READ);
+        capture->widths[slot] = width;
+        capture->heights[slot] = height;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, swapchain.gl.framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    capture->fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    capture->frames[slot] = capture->frame++;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+void frame_capture_stop(FrameCapture* capture) {
+    if (capture->mode == FRAME_CAPTURE_OFF) {
+        return;
+    }
+
+    // oldest first, so the frames are queued in order
+    for (int i = 0; i < FRAME_CAPTURE_RING; i++) {
+        collect(capture, (capture->head + i) % FRAME_CAPTURE_RING, true);
+    }
+    glDeleteBuffers(FRAME_CAPTURE_RING, capture->buffers);
+    sg_reset_state_cache();
+
+    SDL_LockMutex(capture->lock);
+    capture->quit = true;
+    SDL_SignalCondition(capture->cond);
+    SDL_UnlockMutex(capture->lock);
+    SDL_WaitThread(capture->thread, NULL);
+    SDL_DestroyCondition(capture->cond);
+    SDL_DestroyMutex(capture->lock);
+
+    printf("Captured %d frames to %s, %d dropped\n", capture->written, capture->directory, capture->dropped);
+    for (int i = 0; i < FRAME_CAPTURE_QUEUE; i++) {
+        free(capture->queue[i].pixels);
+    }
+    memset(capture, 0, sizeof(FrameCapture));
+}
+
+void frame_capture_frame(FrameCapture* capture, FrameCaptureMode mode, sg_swapchain swapchain) {
+    // a failed start would otherwise be retried, and reported, on every frame
+    if (mode != capture->failed_mode) {
+        capture->failed_mode = FRAME_CAPTURE_OFF;
+    }
+    if (mode != capture->mode && (mode == FRAME_CAPTURE_OFF || mode != capture->failed_mode)) {
+        frame_capture_stop(capture);
+        if (mode != FRAME_CAPTURE_OFF && !start(capture, mode)) {
+            capture->failed_mode = mode;
+        }
+    }
+    if (capture->mode == FRAME_CAPTURE_OFF || swapchain.width <= 0 || swapchain.height <= 0) {
+        return;
+    }
+
+    // the slot about to be reused held frame N-3. if the gpu still hasn't finished it, it's
+    // dropped instead of waited for
+    int slot = capture->head;
+    collect(capture, slot, false);
+    if (capture->fences[slot]) {
+        glDeleteSync((GLsync) capture->fences[slot]);
+        capture->fences[slot] = NULL;
+        capture->dropped++;
+    }
+
+    copy_frame(capture, slot, swapchain);
+    capture->head = (slot + 1) % FRAME_CAPTURE_RING;
+    // frame N-2, two frames old, is normally done by now
+    collect(capture, capture->head, false);
+
+    // sokol caches gl bindings, it has to forget the ones made behind its back
+    sg_reset_state_cache();
+}
+
+#else
+
+void frame_capture_frame(FrameCapture* capture, FrameCaptureMode mode, sg_swapchain swapchain) {
+    (void)swapchain;
+    if (mode != FRAME_CAPTURE_OFF && capture->mode == FRAME_CAPTURE_OFF) {
+        fprintf(stderr, "Frame capture needs a gl backend\n");
+    }
+    // remembered so the message isn't repeated every frame
+    capture->mode = mode;
+}
+
+void frame_capture_stop(FrameCapture* capture) {
+    capture->mode = FRAME_CAPTURE_OFF;
+}
+
+#endif
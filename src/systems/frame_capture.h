@@ -0,0 +1,67 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "sokol_gfx.h"
+
+// records every drawn frame to disk without stalling the gpu. each frame the backbuffer is
+// copied into one of a ring of pixel buffers (an async glReadPixels), and the one written two
+// frames earlier, which the gpu has finished with by then, is mapped and handed to an encoder
+// thread. the render thread only pays for issuing the copy and one memcpy out of the mapped
+// buffer. if the gpu or the encoder falls behind, frames are dropped rather than waited for.
+// gl backends only
+
+#define FRAME_CAPTURE_RING 3    // frame N is copied while N-2 is read
+#define FRAME_CAPTURE_QUEUE 4   // frames waiting for the encoder, more are dropped
+#define FRAME_CAPTURE_DIR "captures"
+
+typedef enum {
+    FRAME_CAPTURE_OFF,
+    FRAME_CAPTURE_RAW,   // frame_NNNNN_WxH.rgba, top row first. cheap enough to keep up
+    FRAME_CAPTURE_PNG    // much slower to encode, expect drops at high resolutions
+} FrameCaptureMode;
+
+typedef struct {
+    unsigned char* pixels;   // bottom row first, as gl reads them. reused between frames
+    size_t capacity;
+    int width, height;
+    int frame;
+} CapturedFrame;
+
+// owned by the thread that draws, apart from the encoder queue
+typedef struct {
+    FrameCaptureMode mode;
+    FrameCaptureMode failed_mode;   // request that couldn't start, not retried until it changes
+    char directory[256];
+    int frame;                // frames copied since capture started
+
+    // pixel buffer ring, gl names
+    unsigned int buffers[FRAME_CAPTURE_RING];
+    void* fences[FRAME_CAPTURE_RING];   // GLsync, set while a copy is in flight
+    int widths[FRAME_CAPTURE_RING];
+    int heights[FRAME_CAPTURE_RING];
+    int frames[FRAME_CAPTURE_RING];
+    int head;                 // slot the next copy goes into
+
+    // encoder
+    SDL_Thread* thread;
+    SDL_Mutex* lock;
+    SDL_Condition* cond;
+    CapturedFrame queue[FRAME_CAPTURE_QUEUE];
+    int queue_head;           // oldest frame waiting
+    int queue_count;          // frames waiting or being written
+    bool quit;
+
+    int written;
+    int dropped;
+} FrameCapture;
+
+// starts, stops or continues recording depending on mode, then copies the frame just drawn
+// into the swapchain. call after sg_commit and before presenting
+void frame_capture_frame(FrameCapture* capture, FrameCaptureMode mode, sg_swapchain swapchain);
+// finishes the copies in flight and the queued frames, blocking
+void frame_capture_stop(FrameCapture* capture);
+
+#endif
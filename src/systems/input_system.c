@@ -1,9 +1,66 @@
 #include "input_system.h"
+#include <stdlib.h>
+#include "systems/build_system.h"
+#include "util/grid_helper.h"
+#include "util/camera.h"
+#include "util/map_loader.h"
 
 void input_system_init(AppState* state) {
     state->input_component = ecs_new(state->ecs);
     ecs_set_name(state->ecs, state->input_component, "InputSingleton");
-    ecs_set(state->ecs, state->input_component, Input, {0});
+    ecs_set(state->ecs, state->input_component, Input, { .place_dir = DIR_RIGHT });
+}
+
+static void update_grid_position(AppState* state, Input* input) {
+    camera_screen_to_world(&state->camera, input->mouse_x, input->mouse_y, &input->world_x, &input->world_y);
+    if (state->map.tiles.isometric) {
+        // the camera looks at the diamond plane, buildings go on the grid underneath it
+        map_iso_to_grid(&state->map, input->world_x, input->world_y, &input->world_x, &input->world_y);
+    }
+    input->grid_x = world_to_tile(input->world_x);
+    input->grid_y = world_to_tile(input->world_y);
+    input->valid_grid_pos = input->grid_x >= 0 && input->grid_y >= 0;
+}
+
+// walk from the last dragged tile to the tile under the mouse one step at a time, so a
+// fast drag still produces a connected run. when the run turns, the previous tile is
+// re-queued facing the new way and becomes the corner.
+static void drag_to(Input* input, int target_x, int target_y, bool removing) {
+    while (input->drag_x != target_x || input->drag_y != target_y) {
+        int dx = target_x - input->drag_x;
+        int dy = target_y - input->drag_y;
+        int prev_x = input->drag_x;
+        int prev_y = input->drag_y;
+        Direction dir;
+
+        if (abs(dx) >= abs(dy)) {
+            dir = dx > 0 ? DIR_RIGHT : DIR_LEFT;
+            input->drag_x += dx > 0 ? 1 : -1;
+        } else {
+            dir = dy > 0 ? DIR_DOWN : DIR_UP;
+            input->drag_y += dy > 0 ? 1 : -1;
+        }
+
+        if (removing) {
+            build_queue_remove(input, input->drag_x, input->drag_y);
+            continue;
+        }
+
+        if (dir != input->place_dir) {
+            input->place_dir = dir;
+            build_queue_place_belt(input, prev_x, prev_y, dir);
+        }
+        build_queue_place_belt(input, input->drag_x, input->drag_y, dir);
+    }
+}
+
+static Direction rotate_clockwise(Direction dir) {
+    switch (dir) {
+        case DIR_UP: return DIR_RIGHT;
+        case DIR_RIGHT: return DIR_DOWN;
+        case DIR_DOWN: return DIR_LEFT;
+        default: return DIR_UP;
+    }
 }
 
 SDL_AppResult handle_input_event(AppState* state, SDL_Event* event) {
@@ -19,6 +76,13 @@ SDL_AppResult handle_input_event(AppState* state, SDL_Event* event) {
             if (event->key.key == SDLK_RIGHT) state->input.right = true;
             if (event->key.key == SDLK_UP) state->input.up = true;
             if (event->key.key == SDLK_DOWN) state->input.down = true;
+            if (event->key.key == SDLK_R) input->place_dir = rotate_clockwise(input->place_dir);
+            if (event->key.key == SDLK_F2) render_scale_cycle(&state->renderer.scale);
+            // shift picks png, slower to encode but no converting afterwards
+            if (event->key.key == SDLK_F3) {
+                state->capture_mode = state->capture_mode != FRAME_CAPTURE_OFF ? FRAME_CAPTURE_OFF :
+                                      (event->key.mod & SDL_KMOD_SHIFT) ? FRAME_CAPTURE_PNG : FRAME_CAPTURE_RAW;
+            }
         break;
 
         case SDL_EVENT_KEY_UP:
@@ -29,10 +93,32 @@ SDL_AppResult handle_input_event(AppState* state, SDL_Event* event) {
             break;
 
         case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            input->mouse_x = event->button.x;
+            input->mouse_y = event->button.y;
+            update_grid_position(state, input);
+
             if (event->button.button == SDL_BUTTON_LEFT) {
                 input->mouse_left_pressed = true;
             } else if (event->button.button == SDL_BUTTON_RIGHT) {
                 input->mouse_right_pressed = true;
+            } else if (event->button.button == SDL_BUTTON_MIDDLE) {
+                input->mouse_middle_pressed = true;
+                break;
+            } else {
+                // side buttons and the like don't build
+                break;
+            }
+
+            // start a drag on the clicked tile
+            if (input->valid_grid_pos && !input->dragging) {
+                input->dragging = true;
+                input->drag_x = input->grid_x;
+                input->drag_y = input->grid_y;
+                if (event->button.button == SDL_BUTTON_LEFT) {
+                    build_queue_place_belt(input, input->grid_x, input->grid_y, input->place_dir);
+                } else {
+                    build_queue_remove(input, input->grid_x, input->grid_y);
+                }
             }
             break;
 
@@ -41,16 +127,32 @@ SDL_AppResult handle_input_event(AppState* state, SDL_Event* event) {
             input->mouse_left_pressed = false;
         } else if (event->button.button == SDL_BUTTON_RIGHT) {
             input->mouse_right_pressed = false;
+        } else if (event->button.button == SDL_BUTTON_MIDDLE) {
+            input->mouse_middle_pressed = false;
+        }
+        if (!input->mouse_left_pressed && !input->mouse_right_pressed) {
+            input->dragging = false;
         }
         break;
             
         case SDL_EVENT_MOUSE_MOTION:
+            if (input->mouse_middle_pressed) {
+                camera_pan(&state->camera, -event->motion.xrel, -event->motion.yrel);
+            }
             input->mouse_x = (int)event->motion.x;
             input->mouse_y = (int)event->motion.y;
+            update_grid_position(state, input);
+
+            if (input->dragging && input->valid_grid_pos) {
+                drag_to(input, input->grid_x, input->grid_y, !input->mouse_left_pressed);
+            }
+            break;
+        case SDL_EVENT_MOUSE_WHEEL:
+            camera_zoom_at(&state->camera, event->wheel.mouse_x, event->wheel.mouse_y, SDL_powf(1.1f, event->wheel.y));
+            update_grid_position(state, input);
             break;
         default:
             break;
     }
     return SDL_APP_CONTINUE;
 }
-    
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "iso_render.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "common.h"
+#include "systems/render_system.h"
+#include "util/map_loader.h"
+#include "util/camera.h"
+#include "systems/tilemap_render.h"
+#include "components/animation.h"
+#include "components/conveyor.h"
+#include "util/stb_ds.h"
+
+// what the extraction jobs read, only used on the simulation thread
+typedef struct {
+    AppState* state;
+    RenderLod lod;
+    float view[4];               // x0, y0, x1, y1
+    DepthEntry* visible;         // the depth order's entries near the view, stb_ds array
+} IsoExtract;
+
+static IsoExtract iso_extract = {0};
+
+static inline uint64_t tile_id(int layer, int tile_x, int tile_y) {
+    return ISO_TILE_ID | ((uint64_t)layer << 48) | ((uint64_t)tile_y << 24) | (uint64_t)tile_x;
+}
+
+// where a sprite touches the ground, on the iso plane. flat things lie around their centre,
+// everything else stands on its bottom edge
+static void ground_point(const Map* map, int layer, const Position* pos, const Sprite* spr,
+                         float* sx, float* sy) {
+    float w = spr->src_w * spr->scale_x;
+    float h = spr->src_h * spr->scale_y;
+    float y = layer < RENDER_LAYER_CHARACTERS ? pos->y + h * 0.5f : pos->y + h;
+    map_grid_to_iso(map, pos->x + w * 0.5f, y, sx, sy);
+}
+
+void iso_render_init(AppState* state) {
+    Map* map = &state->map;
+    IsoScene* iso = &state->iso;
+    if (!map->tiles.isometric) {
+        return;
+    }
+
+    for (int i = 0; i < arrlen(map->tiles.tilesets); i++) {
+        const MapTileset* set = &map->tiles.tilesets[i];
+        int page = -1;
+        if (set->image.id != SG_INVALID_ID) {
+            page = sprite_batch_register_tileset(&state->renderer.sprites, set->image);
+            if (page < 0) {
+                fprintf(stderr, "Sprite batch is out of tileset pages, tiles of firstgid %d aren't depth sorted\n",
+                        set->firstgid);
+            }
+        }
+        arrput(iso->tileset_pages, page);
+    }
+
+    // the layers above the ground stand up, they go in the order with the characters. a tile
+    // sorts by the centre of its diamond
+    for (int l = tilemap_baked_layers(map); l < arrlen(map->tiles.layers); l++) {
+        for (int ty = 0; ty < map->map_height; ty++) {
+            for (int tx = 0; tx < map->map_width; tx++) {
+                uint32_t gid = map_get_tile(map, l, tx, ty);
+                SpriteInstance inst;
+                int ts;
+                if (!gid || !tilemap_tile_instance(map, tx, ty, gid, &inst, &ts) || iso->tileset_pages[ts] < 0) {
+                    continue;
+                }
+                float sx, sy;
+                map_grid_to_iso(map, (tx + 0.5f) * TILE_SIZE, (ty + 0.5f) * TILE_SIZE, &sx, &sy);
+                depth_order_insert(&iso->order, tile_id(l, tx, ty), RENDER_LAYER_CHARACTERS, sy);
+                if (inst.h > iso->reach) iso->reach = inst.h;
+            }
+        }
+    }
+    depth_order_flush(&iso->order);
+}
+
+void iso_render_shutdown(AppState* state) {
+    IsoScene* iso = &state->iso;
+    depth_order_free(&iso->order);
+    arrfree(iso->added);
+    arrfree(iso->tileset_pages);
+}
+
+void iso_render_track(AppState* state, ecs_entity_t entity) {
+    if (state->map.tiles.isometric) {
+        arrput(state->iso.added, entity);
+    }
+}
+
+void iso_render_untrack(AppState* state, ecs_entity_t entity) {
+    IsoScene* iso = &state->iso;
+    if (!state->map.tiles.isometric) {
+        return;
+    }
+    for (int i = 0; i < arrlen(iso->added); i++) {
+        if (iso->added[i] == entity) {
+            arrdelswap(iso->added, i);
+            return;
+        }
+    }
+    depth_order_remove(&iso->order, entity);
+}
+
+void iso_render_moved(AppState* state, ecs_entity_t entity, const Position* pos, const Sprite* spr) {
+    IsoScene* iso = &state->iso;
+    if (!state->map.tiles.isometric) {
+        return;
+    }
+    // things added this frame aren't in the order yet, they get their depth when merged in
+    const DepthEntry* entry = depth_order_get(&iso->order, entity);
+    if (!entry) {
+        return;
+    }
+    float sx, sy;
+    ground_point(&state->map, entry->layer, pos, spr, &sx, &sy);
+    depth_order_move(&iso->order, entity, sy);
+}
+
+// merges what was tracked since the last frame into the order. its layer may have been set
+// after tracking (belts start out as plain sprites), so it's only read now
+static void merge_added(AppState* state) {
+    IsoScene* iso = &state->iso;
+    for (int i = 0; i < arrlen(iso->added); i++) {
+        ecs_entity_t e = iso->added[i];
+        const Position* pos = ecs_get(state->ecs, e, Position);
+        const Sprite* spr = ecs_get(state->ecs, e, Sprite);
+        if (!pos || !spr) {
+            continue;
+        }
+        const RenderLayer* layer = ecs_get(state->ecs, e, RenderLayer);
+        int l = layer ? layer->layer : RENDER_LAYER_GROUND;
+        float sx, sy;
+        ground_point(&state->map, l, pos, spr, &sx, &sy);
+        depth_order_insert(&iso->order, e, l, sy);
+
+        float h = spr->src_h * spr->scale_y;
+        if (h > iso->reach) iso->reach = h;
+    }
+    arrsetlen(iso->added, 0);
+    depth_order_flush(&iso->order);
+}
+
+static bool tile_instance(IsoExtract* ex, const DepthEntry* entry, SpriteInstance* out, uint64_t* key) {
+    const Map* map = &ex->state->map;
+    int layer = (int)((entry->id >> 48) & 0x7FFF);
+    int tile_y = (int)((entry->id >> 24) & 0xFFFFFF);
+    int tile_x = (int)(entry->id & 0xFFFFFF);
+
+    uint32_t gid = map_get_tile(map, layer, tile_x, tile_y);
+    int ts;
+    if (!gid || !tilemap_tile_instance(map, tile_x, tile_y, gid, out, &ts)) {
+        return false;
+    }
+    int page = ex->state->iso.tileset_pages[ts];
+    if (page < 0 || out->x + out->w < ex->view[0] || out->x > ex->view[2] ||
+        out->y + out->h < ex->view[1] || out->y > ex->view[3]) {
+        return false;
+    }
+    *key = sprite_sort_key(RENDER_LAYER_CHARACTERS, page, entry->depth, SPRITE_MATERIAL_DEFAULT);
+    return true;
+}
+
+// a belt at medium zoom: its diamond, and a smaller one in the middle that grows as its lanes
+// fill up. lane strips are rects on the grid, which don't stay rects on the plane
+#define ISO_LANE_SLOTS 2
+static int lane_instances(IsoExtract* ex, const Position* pos, float w, float h, const Conveyor* conv,
+                          SpriteInstance* out, uint64_t* keys) {
+    float tile[4];
+    map_grid_rect_to_iso(&ex->state->map, pos->x, pos->y, w, h, tile);
+    if (tile[0] + tile[2] < ex->view[0] || tile[0] > ex->view[2] ||
+        tile[1] + tile[3] < ex->view[1] || tile[1] > ex->view[3]) {
+        return 0;
+    }
+    sprite_instance_flat(tile[0], tile[1], tile[2], tile[3], RENDER_LAYER_BELTS, SPRITE_PAGE_DIAMOND,
+                         lod_belt_colour, &out[0], &keys[0]);
+
+    int items = 0;
+    for (int lane = 0; lane < CONVEYOR_LANES; lane++) {
+        items += conv->lane_item_count[lane];
+    }
+    float fill = fminf(1.0f, (float)items / (MAX_CONVEYER_ITEMS * CONVEYOR_LANES));
+    if (fill <= 0.0f) {
+        return 1;
+    }
+    // by area, and never hiding the belt completely
+    float scale = 0.8f * sqrtf(fill);
+    float iw = tile[2] * scale, ih = tile[3] * scale;
+    sprite_instance_flat(tile[0] + (tile[2] - iw) * 0.5f, tile[1] + (tile[3] - ih) * 0.5f, iw, ih,
+                         RENDER_LAYER_ITEMS, SPRITE_PAGE_DIAMOND, lod_item_colour, &out[1], &keys[1]);
+    return 2;
+}
+
+// builds the instances of one slice of the visible entries
+static int extract_iso_job(void* ctx, int first, int last, SpriteInstance* instances, uint64_t* keys) {
+    IsoExtract* ex = (IsoExtract*) ctx;
+    AppState* state = ex->state;
+
+    int written = 0;
+    for (int i = first; i < last; i++) {
+        const DepthEntry* entry = &ex->visible[i];
+        SpriteInstance* out = &instances[written];
+        uint64_t* key = &keys[written];
+
+        if (entry->id & ISO_TILE_ID) {
+            if (tile_instance(ex, entry, out, key)) {
+                written++;
+            }
+            continue;
+        }
+
+        // zoomed all the way out the entities are in the chunk tiles, only the map is left
+        if (ex->lod == RENDER_LOD_CHUNKS) {
+            continue;
+        }
+
+        ecs_entity_t e = (ecs_entity_t)entry->id;
+        const Position* pos = ecs_get(state->ecs, e, Position);
+        const Sprite* spr = ecs_get(state->ecs, e, Sprite);
+        if (!pos || !spr) {
+            continue;
+        }
+
+        float w = spr->src_w * spr->scale_x;
+        float h = spr->src_h * spr->scale_y;
+
+        // at medium zoom items only show up as their belt's fill
+        if (ex->lod == RENDER_LOD_LANES) {
+            if (ecs_has(state->ecs, e, ConveyorItem)) {
+                continue;
+            }
+            const Conveyor* conv = ecs_get(state->ecs, e, Conveyor);
+            if (conv) {
+                written += lane_instances(ex, pos, w, h, conv, &instances[written], &keys[written]);
+                continue;
+            }
+        }
+
+        float sx, sy;
+        ground_point(&state->map, entry->layer, pos, spr, &sx, &sy);
+        float x = sx - w * 0.5f;
+        float y = entry->layer < RENDER_LAYER_CHARACTERS ? sy - h * 0.5f : sy - h;
+        if (x + w < ex->view[0] || x > ex->view[2] || y + h < ex->view[1] || y > ex->view[3]) {
+            continue;
+        }
+
+        const ShaderAnimation* anim = ecs_get(state->ecs, e, ShaderAnimation);
+        if (sprite_instance_make(&state->sprite_atlas, spr, x, y, entry->layer, anim ? anim->clip : 0, out, key)) {
+            written++;
+        }
+    }
+    return written;
+}
+
+void iso_render_extract(AppState* state, RenderPacket* packet, int lod) {
+    IsoScene* iso = &state->iso;
+    merge_added(state);
+
+    IsoExtract* ex = &iso_extract;
+    ex->view[0] = packet->view[0];
+    ex->view[1] = packet->view[1];
+    ex->view[2] = packet->view[0] + packet->view[2];
+    ex->view[3] = packet->view[1] + packet->view[3];
+
+    // depth is the ground point's height on screen, so everything that can reach into the view
+    // is one run of each layer. layers are visited back to front, the runs are the draw order
+    arrsetlen(ex->visible, 0);
+    for (int layer = 0; layer < RENDER_LAYER_COUNT; layer++) {
+        int first, last;
+        depth_order_range(&iso->order, layer, ex->view[1] - iso->reach, ex->view[3] + iso->reach, &first, &last);
+        if (last > first) {
+            memcpy(arraddnptr(ex->visible, last - first), &iso->order.entries[first],
+                   (size_t)(last - first) * sizeof(DepthEntry));
+        }
+    }
+
+    ex->state = state;
+    ex->lod = (RenderLod)lod;
+    renderer_extract_parallel(state, &packet->sprites, (int)arrlen(ex->visible),
+                              lod == RENDER_LOD_LANES ? ISO_LANE_SLOTS : 1, extract_iso_job, ex);
+    packet->sprites.presorted = true;
+}
@@ -0,0 +1,46 @@
+#ifndef ISO_RENDER_H
+#define ISO_RENDER_H
+
+#include <stdbool.h>
+#include <flecs.h>
+#include "util/depth_order.h"
+#include "components/transform.h"
+#include "components/sprite.h"
+
+// isometric drawing. entities stay on the square build grid and are projected onto the plane
+// the map's diamonds are drawn on (map_grid_to_iso). everything between the ground tiles and
+// the ui sits in one depth order: the flat layers (belts, items) lie on the ground and come
+// first, then characters, buildings and the map's tall tiles sorted together by where they
+// touch the ground. only things that move are re-sorted, see util/depth_order.h
+
+#define ISO_TILE_ID (1ull << 63)  // ecs ids never use the top bit, map tiles in the order do
+
+struct AppState;
+struct RenderPacket;
+
+typedef struct {
+    DepthOrder order;
+    ecs_entity_t* added;   // tracked since the last extraction, stb_ds array. layer and
+                           // depth are read when they are merged in
+    int* tileset_pages;    // sprite batch page of each map tileset, -1 if it didn't get one
+    float reach;           // tallest thing in the order, how far past the view it can poke in
+} IsoScene;
+
+// collects the tall map tiles, so the map has to be loaded. registers tilesets with the sprite
+// batch, so it has to run before the render thread starts. does nothing for orthogonal maps
+void iso_render_init(struct AppState* state);
+void iso_render_shutdown(struct AppState* state);
+
+// drawable entities coming and going, called by the grid chunk tracking
+void iso_render_track(struct AppState* state, ecs_entity_t entity);
+void iso_render_untrack(struct AppState* state, ecs_entity_t entity);
+// called every tick for the things that can move, only re-sorts if the depth changed
+void iso_render_moved(struct AppState* state, ecs_entity_t entity, const Position* pos, const Sprite* spr);
+
+// appends the packet's sprites in draw order (the batch skips its sort). lod is the camera's
+// RenderLod: at lane detail belts become flat diamonds showing how full they are and items
+// are left out, at chunk detail only the map's tiles are left (the chunk tiles stand in for
+// the entities)
+void iso_render_extract(struct AppState* state, struct RenderPacket* packet, int lod);
+
+#endif
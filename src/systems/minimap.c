@@ -0,0 +1,202 @@
+#include "minimap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "util/grid_helper.h"
+#include "util/camera.h"
+#include "components/conveyor.h"
+#include "systems/render_stats.h"
+
+// abgr, so the bytes land as rgba
+#define MINIMAP_EMPTY 0xFF1C2018u
+#define MINIMAP_BELT 0xFFA09696u
+#define MINIMAP_BUILDING 0xFFDC965Au
+
+static inline uint32_t* page_pixels(Minimap* minimap, int page) {
+    return minimap->pixels + (size_t)page * MINIMAP_PAGE_TILES * MINIMAP_PAGE_TILES;
+}
+
+bool minimap_init(Minimap* minimap, int width, int height) {
+    memset(minimap, 0, sizeof(Minimap));
+    minimap->width = width;
+    minimap->height = height;
+    minimap->pages_x = (width + MINIMAP_PAGE_TILES - 1) / MINIMAP_PAGE_TILES;
+    minimap->pages_y = (height + MINIMAP_PAGE_TILES - 1) / MINIMAP_PAGE_TILES;
+    minimap->chunks_x = (width + MINIMAP_CHUNK_TILES - 1) / MINIMAP_CHUNK_TILES;
+    minimap->chunks_y = (height + MINIMAP_CHUNK_TILES - 1) / MINIMAP_CHUNK_TILES;
+
+    int pages = minimap->pages_x * minimap->pages_y;
+    minimap->pixels = malloc((size_t)pages * MINIMAP_PAGE_TILES * MINIMAP_PAGE_TILES * sizeof(uint32_t));
+    minimap->chunk_dirty = calloc((size_t)minimap->chunks_x * minimap->chunks_y, 1);
+    minimap->page_dirty = calloc((size_t)pages, 1);
+    minimap->images = calloc((size_t)pages, sizeof(sg_image));
+    if (!minimap->pixels || !minimap->chunk_dirty || !minimap->page_dirty || !minimap->images) {
+        fprintf(stderr, "Failed to allocate minimap\n");
+        minimap_shutdown(minimap);
+        return false;
+    }
+
+    // the grid starts out empty, so the first upload is the only full one
+    for (int i = 0; i < pages * MINIMAP_PAGE_TILES * MINIMAP_PAGE_TILES; i++) {
+        minimap->pixels[i] = MINIMAP_EMPTY;
+    }
+    for (int p = 0; p < pages; p++) {
+        minimap->images[p] = sg_make_image(&(sg_image_desc) {
+            .usage = { .dynamic_update = true },
+            .width = MINIMAP_PAGE_TILES,
+            .height = MINIMAP_PAGE_TILES,
+            .pixel_format = SG_PIXELFORMAT_RGBA8,
+            .label = "minimap-page"
+        });
+        minimap->page_dirty[p] = 1;
+    }
+
+    minimap->sampler = sg_make_sampler(&(sg_sampler_desc) {
+        .min_filter = SG_FILTER_NEAREST,
+        .mag_filter = SG_FILTER_NEAREST,
+        .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+        .wrap_v = SG_WRAP_CLAMP_TO_EDGE
+    });
+    return true;
+}
+
+void minimap_shutdown(Minimap* minimap) {
+    if (minimap->images) {
+        for (int p = 0; p < minimap->pages_x * minimap->pages_y; p++) {
+            sg_destroy_image(minimap->images[p]);
+        }
+    }
+    sg_destroy_sampler(minimap->sampler);
+    free(minimap->pixels);
+    free(minimap->chunk_dirty);
+    free(minimap->page_dirty);
+    free(minimap->images);
+    arrfree(minimap->dirty_chunks);
+    memset(minimap, 0, sizeof(Minimap));
+}
+
+void minimap_mark_dirty(Minimap* minimap, int tile_x, int tile_y) {
+    if (tile_x < 0 || tile_y < 0 || tile_x >= minimap->width || tile_y >= minimap->height) {
+        return;
+    }
+    int chunk = (tile_y / MINIMAP_CHUNK_TILES) * minimap->chunks_x + tile_x / MINIMAP_CHUNK_TILES;
+    if (!minimap->chunk_dirty[chunk]) {
+        minimap->chunk_dirty[chunk] = 1;
+        arrput(minimap->dirty_chunks, chunk);
+    }
+}
+
+static void recolour_chunk(AppState* state, Minimap* minimap, int chunk) {
+    int tx0 = (chunk % minimap->chunks_x) * MINIMAP_CHUNK_TILES;
+    int ty0 = (chunk / minimap->chunks_x) * MINIMAP_CHUNK_TILES;
+    int tx1 = tx0 + MINIMAP_CHUNK_TILES, ty1 = ty0 + MINIMAP_CHUNK_TILES;
+    if (tx1 > minimap->width) tx1 = minimap->width;
+    if (ty1 > minimap->height) ty1 = minimap->height;
+
+    // a chunk never straddles a page, the page size is a multiple of the chunk size
+    int page = (ty0 / MINIMAP_PAGE_TILES) * minimap->pages_x + tx0 / MINIMAP_PAGE_TILES;
+    uint32_t* pixels = page_pixels(minimap, page);
+
+    for (int ty = ty0; ty < ty1; ty++) {
+        for (int tx = tx0; tx < tx1; tx++) {
+            ecs_entity_t e = get_entity_at_grid_position(state, tx * TILE_SIZE, ty * TILE_SIZE);
+            uint32_t colour = MINIMAP_EMPTY;
+            if (e && ecs_is_alive(state->ecs, e)) {
+                colour = ecs_has(state->ecs, e, Conveyor) ? MINIMAP_BELT : MINIMAP_BUILDING;
+            }
+            pixels[(ty % MINIMAP_PAGE_TILES) * MINIMAP_PAGE_TILES + tx % MINIMAP_PAGE_TILES] = colour;
+        }
+    }
+    minimap->page_dirty[page] = 1;
+}
+
+void minimap_extract(AppState* state, RenderPacket* packet) {
+    Minimap* minimap = &state->minimap;
+    if (!minimap->pixels) {
+        return;
+    }
+
+    for (int i = 0; i < arrlen(minimap->dirty_chunks); i++) {
+        recolour_chunk(state, minimap, minimap->dirty_chunks[i]);
+        minimap->chunk_dirty[minimap->dirty_chunks[i]] = 0;
+    }
+    arrsetlen(minimap->dirty_chunks, 0);
+
+    size_t page_size = (size_t)MINIMAP_PAGE_TILES * MINIMAP_PAGE_TILES * sizeof(uint32_t);
+    for (int p = 0; p < minimap->pages_x * minimap->pages_y; p++) {
+        if (!minimap->page_dirty[p]) {
+            continue;
+        }
+        uint32_t* copy = malloc(page_size);
+        if (!copy) {
+            continue;  // stays dirty, tried again next frame
+        }
+        memcpy(copy, page_pixels(minimap, p), page_size);
+        arrput(packet->minimap_uploads, ((MinimapUpload) { p, copy }));
+        minimap->page_dirty[p] = 0;
+    }
+}
+
+void minimap_upload(AppState* state, RenderPacket* packet) {
+    Minimap* minimap = &state->minimap;
+    size_t page_size = (size_t)MINIMAP_PAGE_TILES * MINIMAP_PAGE_TILES * sizeof(uint32_t);
+
+    // a page changes at most once per packet, which is all sokol allows per frame
+    for (int i = 0; i < arrlen(packet->minimap_uploads); i++) {
+        MinimapUpload* up = &packet->minimap_uploads[i];
+        sg_update_image(minimap->images[up->page], &(sg_image_data) {
+            .subimage[0][0] = { up->pixels, page_size }
+        });
+        free(up->pixels);
+    }
+    arrsetlen(packet->minimap_uploads, 0);
+}
+
+void minimap_draw(AppState* state, RenderPacket* packet) {
+    Minimap* minimap = &state->minimap;
+    if (!minimap->images || minimap->width <= 0 || minimap->height <= 0) {
+        return;
+    }
+
+    // bottom right corner, longest side MINIMAP_MAX_SIZE
+    float scale = (float)MINIMAP_MAX_SIZE / (minimap->width > minimap->height ? minimap->width : minimap->height);
+    float x0 = packet->width - MINIMAP_MARGIN - minimap->width * scale;
+    float y0 = packet->height - MINIMAP_MARGIN - minimap->height * scale;
+
+    int pages = renderer_sgp_room(minimap->pages_x * minimap->pages_y, 6, minimap->pages_x * minimap->pages_y);
+    sgp_set_color(1.0f, 1.0f, 1.0f, 1.0f);
+    sgp_set_sampler(0, minimap->sampler);
+    for (int py = 0; py < minimap->pages_y; py++) {
+        for (int px = 0; px < minimap->pages_x && py * minimap->pages_x + px < pages; px++) {
+            // edge pages are only partly used
+            int w = minimap->width - px * MINIMAP_PAGE_TILES;
+            int h = minimap->height - py * MINIMAP_PAGE_TILES;
+            if (w > MINIMAP_PAGE_TILES) w = MINIMAP_PAGE_TILES;
+            if (h > MINIMAP_PAGE_TILES) h = MINIMAP_PAGE_TILES;
+
+            sgp_set_image(0, minimap->images[py * minimap->pages_x + px]);
+            sgp_draw_textured_rect(0,
+                (sgp_rect) { x0 + px * MINIMAP_PAGE_TILES * scale, y0 + py * MINIMAP_PAGE_TILES * scale, w * scale, h * scale },
+                (sgp_rect) { 0, 0, (float)w, (float)h });
+        }
+    }
+    sgp_reset_image(0);
+    sgp_reset_sampler(0);
+
+    // what the camera sees, clipped to the map. on isometric maps that's a diamond
+    float s = scale / TILE_SIZE;
+    // the scissor is in backbuffer pixels, not the ui's window coordinates
+    float density = packet->width > 0 ? (float)packet->pixel_width / packet->width : 1.0f;
+    sgp_scissor((int)(x0 * density), (int)(y0 * density), (int)(minimap->width * scale * density),
+                (int)(minimap->height * scale * density));
+    sgp_set_color(1.0f, 1.0f, 1.0f, 1.0f);
+    int lines = renderer_sgp_room(4, 2, 0);
+    for (int i = 0; i < lines; i++) {
+        const float* a = packet->ground[i];
+        const float* b = packet->ground[(i + 1) % 4];
+        sgp_draw_line(x0 + a[0] * s, y0 + a[1] * s, x0 + b[0] * s, y0 + b[1] * s);
+    }
+    sgp_reset_color();
+    sgp_reset_scissor();
+}
@@ -0,0 +1,52 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sokol_gfx.h"
+
+// overview of the build grid, one pixel per tile. the texture is split into pages so a
+// change only re-uploads the page it lands in (sokol can't update part of an image).
+// grid edits mark their chunk dirty, extraction recolours dirty chunks into the cpu copy
+// and hands changed pages to the renderer. nothing is ever redrawn from scratch
+
+#define MINIMAP_PAGE_TILES 128   // page side in tiles, 64k per upload
+#define MINIMAP_CHUNK_TILES 16   // matches GRID_CHUNK_SIZE
+#define MINIMAP_MAX_SIZE 200     // longest side on screen, in pixels
+#define MINIMAP_MARGIN 10
+
+struct AppState;
+struct RenderPacket;
+
+// a page's pixels, copied for the render thread to upload
+typedef struct {
+    int page;
+    uint32_t* pixels;  // MINIMAP_PAGE_TILES squared, malloc'd
+} MinimapUpload;
+
+typedef struct {
+    int width, height;         // in tiles
+    int pages_x, pages_y;
+    int chunks_x, chunks_y;
+    uint32_t* pixels;          // page by page, MINIMAP_PAGE_TILES squared each
+    uint8_t* chunk_dirty;      // one flag per chunk
+    int* dirty_chunks;         // stb_ds array of chunk indices
+    uint8_t* page_dirty;       // one flag per page
+    sg_image* images;          // one per page, owned by the thread that draws
+    sg_sampler sampler;
+} Minimap;
+
+// makes the page images, so has to run before the render thread starts
+bool minimap_init(Minimap* minimap, int width, int height);
+void minimap_shutdown(Minimap* minimap);
+
+// called whenever the grid changes at a tile
+void minimap_mark_dirty(Minimap* minimap, int tile_x, int tile_y);
+
+// simulation side: recolours dirty chunks and queues their pages on the packet
+void minimap_extract(struct AppState* state, struct RenderPacket* packet);
+// render side: the packet's page uploads (outside any pass), then the overlay in screen space
+void minimap_upload(struct AppState* state, struct RenderPacket* packet);
+void minimap_draw(struct AppState* state, struct RenderPacket* packet);
+
+#endif
@@ -0,0 +1,287 @@
+#include "particles.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "common.h"
+#include "shader.glsl.h"
+#include "components/transform.h"
+#include "components/sprite.h"
+#include "util/map_loader.h"
+#include "systems/render_stats.h"
+#include "util/stb_ds.h"
+
+#define PARTICLE_ALIGN 32  // one avx register of floats, every field array starts on one
+
+// what a kind of particle starts out as, each value is picked in [min, max]
+typedef struct {
+    float life_min, life_max;    // seconds
+    float speed_min, speed_max;  // world pixels per second
+    float angle, spread;         // direction in radians (0 is right, y points down) and its +- range
+    float ax, ay;
+    float size, grow;
+    uint8_t colour[4];
+} ParticleKindDesc;
+
+static const ParticleKindDesc particle_kinds[PARTICLE_KIND_COUNT] = {
+    // slow grey puffs that drift up and swell as they fade
+    [PARTICLE_SMOKE] = { 1.5f, 3.0f, 8.0f, 20.0f, -1.5708f, 0.6f, 0.0f, -6.0f, 6.0f, 10.0f, { 110, 110, 110, 150 } },
+    // fast and short lived, thrown up and pulled back down
+    [PARTICLE_SPARK] = { 0.2f, 0.5f, 60.0f, 160.0f, -1.5708f, 1.4f, 0.0f, 400.0f, 3.0f, -3.0f, { 255, 190, 80, 255 } },
+};
+
+static float* float_field(void) {
+    return SDL_aligned_alloc(PARTICLE_ALIGN, PARTICLE_CAPACITY * sizeof(float));
+}
+
+bool particles_init(ParticlePool* pool) {
+    memset(pool, 0, sizeof(ParticlePool));
+    pool->x = float_field();
+    pool->y = float_field();
+    pool->vx = float_field();
+    pool->vy = float_field();
+    pool->ax = float_field();
+    pool->ay = float_field();
+    pool->size = float_field();
+    pool->grow = float_field();
+    pool->life = float_field();
+    pool->inv_life = float_field();
+    pool->colour = SDL_aligned_alloc(PARTICLE_ALIGN, PARTICLE_CAPACITY * sizeof(uint32_t));
+    pool->seed = 0x9E3779B9u;
+
+    if (!pool->x || !pool->y || !pool->vx || !pool->vy || !pool->ax || !pool->ay || !pool->size ||
+        !pool->grow || !pool->life || !pool->inv_life || !pool->colour) {
+        fprintf(stderr, "failed to allocate %d particles\n", PARTICLE_CAPACITY);
+        particles_shutdown(pool);
+        return false;
+    }
+    return true;
+}
+
+void particles_shutdown(ParticlePool* pool) {
+    SDL_aligned_free(pool->x);
+    SDL_aligned_free(pool->y);
+    SDL_aligned_free(pool->vx);
+    SDL_aligned_free(pool->vy);
+    SDL_aligned_free(pool->ax);
+    SDL_aligned_free(pool->ay);
+    SDL_aligned_free(pool->size);
+    SDL_aligned_free(pool->grow);
+    SDL_aligned_free(pool->life);
+    SDL_aligned_free(pool->inv_life);
+    SDL_aligned_free(pool->colour);
+    memset(pool, 0, sizeof(ParticlePool));
+}
+
+// xorshift, particles don't need anything better and it keeps headless runs repeatable
+static inline float random_range(ParticlePool* pool, float lo, float hi) {
+    uint32_t s = pool->seed;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    pool->seed = s;
+    return lo + (hi - lo) * (float)(s >> 8) * (1.0f / 16777216.0f);
+}
+
+void particles_emit(ParticlePool* pool, ParticleKind kind, float x, float y, int count) {
+    if (!pool->x) {
+        return;
+    }
+    const ParticleKindDesc* desc = &particle_kinds[kind];
+    if (count > PARTICLE_CAPACITY - pool->count) {
+        count = PARTICLE_CAPACITY - pool->count;
+    }
+
+    uint32_t colour;
+    memcpy(&colour, desc->colour, sizeof(colour));
+    for (int n = 0; n < count; n++) {
+        int i = pool->count++;
+        float angle = desc->angle + random_range(pool, -desc->spread, desc->spread);
+        float speed = random_range(pool, desc->speed_min, desc->speed_max);
+        float life = random_range(pool, desc->life_min, desc->life_max);
+        pool->x[i] = x;
+        pool->y[i] = y;
+        pool->vx[i] = cosf(angle) * speed;
+        pool->vy[i] = sinf(angle) * speed;
+        pool->ax[i] = desc->ax;
+        pool->ay[i] = desc->ay;
+        pool->size[i] = desc->size;
+        pool->grow[i] = desc->grow;
+        pool->life[i] = life;
+        pool->inv_life[i] = 1.0f / life;
+        pool->colour[i] = colour;
+    }
+}
+
+void particles_emit_at(AppState* state, ParticleKind kind, float grid_x, float grid_y, int count) {
+    float x = grid_x, y = grid_y;
+    if (state->map.tiles.isometric) {
+        map_grid_to_iso(&state->map, grid_x, grid_y, &x, &y);
+    }
+    particles_emit(&state->particles, kind, x, y, count);
+}
+
+// every field is its own array and nothing branches, so this is one vectorised pass
+static void simulate(ParticlePool* pool, float dt) {
+    int n = pool->count;
+    float* restrict x = pool->x;
+    float* restrict y = pool->y;
+    float* restrict vx = pool->vx;
+    float* restrict vy = pool->vy;
+    const float* restrict ax = pool->ax;
+    const float* restrict ay = pool->ay;
+    float* restrict size = pool->size;
+    const float* restrict grow = pool->grow;
+    float* restrict life = pool->life;
+
+    for (int i = 0; i < n; i++) {
+        vx[i] += ax[i] * dt;
+        vy[i] += ay[i] * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        size[i] += grow[i] * dt;
+        life[i] -= dt;
+    }
+}
+
+// dead particles take the last live one's place, so the live ones stay packed at the front
+static void retire(ParticlePool* pool) {
+    int i = 0;
+    while (i < pool->count) {
+        if (pool->life[i] > 0.0f) {
+            i++;
+            continue;
+        }
+        int last = --pool->count;
+        pool->x[i] = pool->x[last];
+        pool->y[i] = pool->y[last];
+        pool->vx[i] = pool->vx[last];
+        pool->vy[i] = pool->vy[last];
+        pool->ax[i] = pool->ax[last];
+        pool->ay[i] = pool->ay[last];
+        pool->size[i] = pool->size[last];
+        pool->grow[i] = pool->grow[last];
+        pool->life[i] = pool->life[last];
+        pool->inv_life[i] = pool->inv_life[last];
+        pool->colour[i] = pool->colour[last];
+    }
+}
+
+void particles_update(AppState* state, float dt) {
+    ParticlePool* pool = &state->particles;
+
+    // machines puff away at a steady rate, the fraction carries over to the next tick
+    ecs_iter_t it = ecs_query_iter(state->ecs, state->renderer.queries.particles);
+    while (ecs_query_next(&it)) {
+        Position* pos = ecs_field(&it, Position, 0);
+        ParticleEmitter* emitter = ecs_field(&it, ParticleEmitter, 1);
+        for (int i = 0; i < it.count; i++) {
+            emitter[i].timer += emitter[i].rate * dt;
+            int count = (int)emitter[i].timer;
+            if (count > 0) {
+                emitter[i].timer -= (float)count;
+                particles_emit_at(state, (ParticleKind)emitter[i].kind, pos[i].x + emitter[i].offset_x,
+                                  pos[i].y + emitter[i].offset_y, count);
+            }
+        }
+    }
+
+    simulate(pool, dt);
+    retire(pool);
+}
+
+void particles_extract(const ParticlePool* pool, const float view[4], ParticleInstance** out) {
+    int n = pool->count;
+    if (n == 0) {
+        return;
+    }
+    float x0 = view[0], y0 = view[1], x1 = view[0] + view[2], y1 = view[1] + view[3];
+
+    ParticleInstance* dst = arraddnptr(*out, n);
+    int written = 0;
+    for (int i = 0; i < n; i++) {
+        float x = pool->x[i], y = pool->y[i];
+        float r = pool->size[i] * 0.5f;
+        if (x + r < x0 || x - r > x1 || y + r < y0 || y - r > y1) {
+            continue;
+        }
+        ParticleInstance* inst = &dst[written++];
+        inst->x = x;
+        inst->y = y;
+        inst->size = pool->size[i];
+        memcpy(inst->colour, &pool->colour[i], sizeof(inst->colour));
+        inst->colour[3] = (uint8_t)(inst->colour[3] * pool->life[i] * pool->inv_life[i]);
+    }
+    arrsetlen(*out, arrlen(*out) - (n - written));
+}
+
+bool particles_render_init(AppState* state) {
+    Renderer* renderer = &state->renderer;
+    renderer->particle_shader = sg_make_shader(sgp_particle_shader_desc(sg_query_backend()));
+    if (sg_query_shader_state(renderer->particle_shader) != SG_RESOURCESTATE_VALID) {
+        fprintf(stderr, "failed to make particle shader\n");
+        return false;
+    }
+
+    // one instance per particle, the quad's corners come from the vertex index
+    renderer->particle_pipeline = sg_make_pipeline(&(sg_pipeline_desc) {
+        .shader = renderer->particle_shader,
+        .layout = {
+            .buffers[0] = { .stride = sizeof(ParticleInstance), .step_func = SG_VERTEXSTEP_PER_INSTANCE },
+            .attrs = {
+                [ATTR_particle_part_pos] = { .offset = offsetof(ParticleInstance, x), .format = SG_VERTEXFORMAT_FLOAT3 },
+                [ATTR_particle_part_colour] = { .offset = offsetof(ParticleInstance, colour), .format = SG_VERTEXFORMAT_UBYTE4N }
+            }
+        },
+        .colors[0].blend = {
+            .enabled = true,
+            .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+            .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+            .src_factor_alpha = SG_BLENDFACTOR_ONE,
+            .dst_factor_alpha = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA
+        },
+        .label = "particle-pipeline"
+    });
+
+    // sized for a full pool up front, so it never has to grow
+    renderer->particle_buffer = sg_make_buffer(&(sg_buffer_desc) {
+        .size = PARTICLE_CAPACITY * sizeof(ParticleInstance),
+        .usage = { .vertex_buffer = true, .stream_update = true },
+        .label = "particle-instances"
+    });
+
+    return sg_query_pipeline_state(renderer->particle_pipeline) == SG_RESOURCESTATE_VALID &&
+           sg_query_buffer_state(renderer->particle_buffer) == SG_RESOURCESTATE_VALID;
+}
+
+void particles_render_shutdown(AppState* state) {
+    Renderer* renderer = &state->renderer;
+    sg_destroy_buffer(renderer->particle_buffer);
+    sg_destroy_pipeline(renderer->particle_pipeline);
+    sg_destroy_shader(renderer->particle_shader);
+}
+
+void particles_draw(AppState* state, const ParticleInstance* instances, int count, const float view[4]) {
+    Renderer* renderer = &state->renderer;
+    if (count <= 0 || renderer->particle_buffer.id == SG_INVALID_ID) {
+        return;
+    }
+    if (count > PARTICLE_CAPACITY) {
+        count = PARTICLE_CAPACITY;
+    }
+
+    // drawn once per frame, so a plain update. the buffer is sized for the whole pool
+    sg_update_buffer(renderer->particle_buffer, &(sg_range) {
+        .ptr = instances,
+        .size = (size_t)count * sizeof(ParticleInstance)
+    });
+
+    particle_vs_params_t params = {
+        .view = { view[0], view[1], view[2], view[3] }
+    };
+    sg_apply_pipeline(renderer->particle_pipeline);
+    sg_apply_bindings(&(sg_bindings) { .vertex_buffers[0] = renderer->particle_buffer });
+    sg_apply_uniforms(UB_particle_vs_params, &SG_RANGE(params));
+    sg_draw(0, 6, count);
+    render_stats_count(6 * (uint32_t)count, 0);
+}
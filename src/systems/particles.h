@@ -0,0 +1,66 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// smoke, sparks and the like. particles aren't entities: they live in one fixed size pool kept
+// as separate arrays per field (so the update is a flat loop over floats the compiler can
+// vectorise) and are drawn with a single instanced call. emitting into a full pool drops the
+// new particles, nothing is allocated after init
+
+#define PARTICLE_CAPACITY 65536
+
+typedef enum {
+    PARTICLE_SMOKE,
+    PARTICLE_SPARK,
+    PARTICLE_KIND_COUNT
+} ParticleKind;
+
+// one record per particle on the gpu, 16 bytes
+typedef struct {
+    float x, y;        // centre, in the space the world is drawn in
+    float size;
+    uint8_t colour[4]; // already faded
+} ParticleInstance;
+
+// simulated on the main thread, extraction copies the live ones into the packet
+typedef struct {
+    int count;                 // live particles are [0, count)
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* ax;                 // constant acceleration, gravity for sparks, lift for smoke
+    float* ay;
+    float* size;
+    float* grow;               // size change per second
+    float* life;               // seconds left
+    float* inv_life;           // 1 / starting life, for the fade
+    uint32_t* colour;          // rgba8 at full life
+    uint32_t seed;
+} ParticlePool;
+
+struct AppState;
+
+bool particles_init(ParticlePool* pool);
+void particles_shutdown(ParticlePool* pool);
+
+// count particles of kind spreading out from x, y in draw space
+void particles_emit(ParticlePool* pool, ParticleKind kind, float x, float y, int count);
+// same from a point on the build grid, projected onto the diamond plane on isometric maps
+void particles_emit_at(struct AppState* state, ParticleKind kind, float grid_x, float grid_y, int count);
+
+// runs the ParticleEmitter entities, then moves, ages and retires every particle
+void particles_update(struct AppState* state, float dt);
+// faded instances of the live particles overlapping view, appended to out (stb_ds array)
+void particles_extract(const ParticlePool* pool, const float view[4], ParticleInstance** out);
+
+// the renderer's particle shader, pipeline and instance buffer (PARTICLE_CAPACITY instances)
+bool particles_render_init(struct AppState* state);
+void particles_render_shutdown(struct AppState* state);
+// uploads the instances and draws them all with one call. has to be inside a pass, after
+// sgp_flush so they land on top of the sprites
+void particles_draw(struct AppState* state, const ParticleInstance* instances, int count, const float view[4]);
+
+#endif
@@ -0,0 +1,119 @@
+#include "render_scale.h"
+#include <stdio.h>
+#include <math.h>
+#include "sokol_gp.h"
+#include "systems/render_stats.h"
+
+void render_scale_init(RenderScale* scale, float setting, bool adaptive, float budget) {
+    *scale = (RenderScale) {
+        .setting = setting,
+        .current = setting,
+        .adaptive = adaptive,
+        .budget = budget,
+        .average = budget
+    };
+}
+
+void render_scale_update(RenderScale* scale, float frame_time) {
+    if (!scale->adaptive) {
+        scale->current = scale->setting;
+        return;
+    }
+
+    // smoothed over roughly the last 20 frames, so one hitch doesn't count
+    scale->average += (frame_time - scale->average) * 0.05f;
+    scale->cooldown -= frame_time;
+    if (scale->current > scale->setting) {
+        scale->current = scale->setting;
+    }
+    if (scale->cooldown > 0.0f) {
+        return;
+    }
+
+    if (scale->average > scale->budget * RENDER_SCALE_OVER && scale->current > RENDER_SCALE_MIN) {
+        scale->current = fmaxf(RENDER_SCALE_MIN, scale->current - RENDER_SCALE_STEP_DOWN);
+        scale->cooldown = RENDER_SCALE_DOWN_WAIT;
+    } else if (scale->average < scale->budget * RENDER_SCALE_UNDER && scale->current < scale->setting) {
+        scale->current = fminf(scale->setting, scale->current + RENDER_SCALE_STEP_UP);
+        scale->cooldown = RENDER_SCALE_UP_WAIT;
+    }
+}
+
+void render_scale_cycle(RenderScale* scale) {
+    scale->setting = scale->setting > 0.9f ? 0.75f : scale->setting > 0.6f ? 0.5f : 1.0f;
+    scale->current = scale->setting;
+    scale->cooldown = RENDER_SCALE_UP_WAIT;
+    printf("Render scale %.2f%s\n", scale->setting, scale->adaptive ? " (adaptive)" : "");
+}
+
+void scene_target_destroy(SceneTarget* target) {
+    sg_destroy_attachments(target->pass);
+    sg_destroy_image(target->color);
+    sg_destroy_image(target->depth);
+    sg_destroy_sampler(target->sampler);
+    *target = (SceneTarget) {0};
+}
+
+bool scene_target_resize(SceneTarget* target, int width, int height) {
+    if (target->pass.id != SG_INVALID_ID && target->width == width && target->height == height) {
+        return true;
+    }
+    scene_target_destroy(target);
+
+    // same formats as the backbuffer, so the sprite and sokol_gp pipelines work with both
+    target->color = sg_make_image(&(sg_image_desc) {
+        .usage = { .render_attachment = true },
+        .width = width,
+        .height = height,
+        .label = "scene-color"
+    });
+    target->depth = sg_make_image(&(sg_image_desc) {
+        .usage = { .render_attachment = true },
+        .width = width,
+        .height = height,
+        .pixel_format = SG_PIXELFORMAT_DEPTH_STENCIL,
+        .label = "scene-depth"
+    });
+    target->pass = sg_make_attachments(&(sg_attachments_desc) {
+        .colors[0].image = target->color,
+        .depth_stencil.image = target->depth,
+        .label = "scene-pass"
+    });
+    // smooth stretching, the scale is rarely a whole fraction
+    target->sampler = sg_make_sampler(&(sg_sampler_desc) {
+        .min_filter = SG_FILTER_LINEAR,
+        .mag_filter = SG_FILTER_LINEAR,
+        .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+        .wrap_v = SG_WRAP_CLAMP_TO_EDGE
+    });
+    target->width = width;
+    target->height = height;
+
+    if (sg_query_attachments_state(target->pass) != SG_RESOURCESTATE_VALID) {
+        fprintf(stderr, "failed to make %dx%d scene target\n", width, height);
+        scene_target_destroy(target);
+        return false;
+    }
+    return true;
+}
+
+void scene_target_draw(SceneTarget* target, float width, float height) {
+    if (renderer_sgp_room(1, 6, 1) == 0) {
+        return;
+    }
+    sgp_set_image(0, target->color);
+    sgp_set_sampler(0, target->sampler);
+
+    // gl render targets are stored bottom row first
+    sgp_push_transform();
+    if (!sg_query_features().origin_top_left) {
+        sgp_translate(0.0f, height);
+        sgp_scale(1.0f, -1.0f);
+    }
+    sgp_draw_textured_rect(0, (sgp_rect) { 0.0f, 0.0f, width, height },
+                           (sgp_rect) { 0.0f, 0.0f, (float)target->width, (float)target->height });
+    sgp_pop_transform();
+
+    sgp_reset_image(0);
+    sgp_reset_sampler(0);
+}
@@ -0,0 +1,50 @@
+#ifndef RENDER_SCALE_H
+#define RENDER_SCALE_H
+
+#include <stdbool.h>
+#include "sokol_gfx.h"
+
+// the world can be drawn into an offscreen target smaller than the backbuffer and stretched
+// over it, text and the minimap are drawn afterwards at full resolution. the fraction drops
+// on its own when frames run over budget and creeps back up once there is room again
+
+#define RENDER_SCALE_MIN 0.5f
+#define RENDER_SCALE_BUDGET (1.0f / 60.0f)
+#define RENDER_SCALE_STEP_DOWN 0.1f
+#define RENDER_SCALE_STEP_UP 0.05f
+#define RENDER_SCALE_DOWN_WAIT 0.5f   // seconds between drops
+#define RENDER_SCALE_UP_WAIT 2.0f     // seconds between raises, slower so it doesn't flap
+#define RENDER_SCALE_OVER 1.15f       // average frame time over budget * this drops the scale
+#define RENDER_SCALE_UNDER 0.85f      // under budget * this raises it
+
+// updated on the simulation thread, which copies current into each packet
+typedef struct {
+    float setting;    // what the user picked, adapting never goes above it
+    float current;    // what frames are drawn at
+    bool adaptive;
+    float budget;     // frame time target in seconds
+    float average;    // smoothed frame time
+    float cooldown;   // seconds until the next change
+} RenderScale;
+
+// the scaled target, owned by the thread that draws
+typedef struct {
+    sg_image color;
+    sg_image depth;
+    sg_attachments pass;
+    sg_sampler sampler;
+    int width, height;
+} SceneTarget;
+
+void render_scale_init(RenderScale* scale, float setting, bool adaptive, float budget);
+void render_scale_update(RenderScale* scale, float frame_time);
+// steps the setting through 1, 0.75 and 0.5
+void render_scale_cycle(RenderScale* scale);
+
+// (re)makes the target if the size changed
+bool scene_target_resize(SceneTarget* target, int width, int height);
+void scene_target_destroy(SceneTarget* target);
+// stretches the target over (0, 0, width, height) of the current sokol_gp projection
+void scene_target_draw(SceneTarget* target, float width, float height);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// per frame counters, only touched by the thread that draws. draw calls come from sokol,
+// which also sees sokol_gp's batches; vertices and texture binds are counted where we
+// submit them (sprite batch, text, sokol_gp shapes)
+typedef struct {
+    uint32_t draw_calls;
+    uint32_t vertices;
+    uint32_t texture_binds;
+    // sokol_gp's share of vertices has to fit its fixed buffer, see renderer_sgp_reserve
+    uint32_t sgp_vertices;
+    uint32_t sgp_capacity;       // vertices its buffer held this frame
+    uint32_t sgp_peak;           // most sgp_vertices any frame has used so far
+    uint32_t sgp_overflows;      // frames that ran out and lost what didn't fit, so far
+} RenderStats;
+
+extern RenderStats render_stats;       // frame being drawn
+extern RenderStats render_stats_last;  // last finished frame
+
+static inline void render_stats_count(uint32_t vertices, uint32_t texture_binds) {
+    render_stats.vertices += vertices;
+    render_stats.texture_binds += texture_binds;
+}
+
+// call after sg_commit, picks up sokol's draw count and starts the next frame
+void render_stats_end_frame(void);
+
+// sokol_gp starts with room for the overlays and a few thousand coloured rects, and is made
+// again bigger between frames when a frame needs more. its vertex buffer is appended to by
+// every flush, so it has to hold the whole frame, the command list only one flush's worth
+#define RENDER_SGP_VERTICES (6 * 32768)
+#define RENDER_SGP_COMMANDS 16384
+#define RENDER_SGP_OVERLAY_VERTICES (6 * 4096)  // text, minimap and anything else not counted up front
+#define RENDER_SGP_FLUSH_QUADS 8192             // rects asked room for at a time
+
+struct AppState;
+
+// sets sokol_gp up with room for this many vertices and commands, backends call it once at init
+bool renderer_sgp_setup(struct AppState* state, uint32_t vertices, uint32_t commands);
+// call after each sgp_end, notes a frame that ran out so the next one gets more room
+void renderer_sgp_check(struct AppState* state);
+// call before queuing quads through sokol_gp, returns how many of them to draw and counts
+// them. once sokol_gp runs out of room it drops everything queued since its last flush, so
+// quads past this frame's vertex buffer are skipped instead and the next frame gets a bigger
+// one. the command list only holds one flush, so it's flushed early rather than filled
+int renderer_sgp_room(int quads, uint32_t vertices_per_quad, uint32_t texture_binds);
+
+#endif
@@ -1,11 +1,67 @@
 #include "render_system.h"
 #include "window.h"
 #include <stdio.h>
+#include <math.h>
+#include "util/grid_helper.h"
+#include "util/camera.h"
+#include "util/map_loader.h"
+#include "components/conveyor.h"
+#include "systems/tilemap_render.h"
+#include "util/job_pool.h"
+#include "systems/minimap.h"
+#include "systems/render_stats.h"
 
 // move this to an entity
 // FPS counter state
 
 fps_counter_t fps_counter = {0};
+RenderStats render_stats = {0};
+RenderStats render_stats_last = {0};
+
+void render_stats_end_frame(void) {
+    render_stats.draw_calls = sg_query_frame_stats().num_draw;
+    // the high-water marks carry over from frame to frame
+    render_stats.sgp_peak = render_stats_last.sgp_peak;
+    if (render_stats.sgp_vertices > render_stats.sgp_peak) {
+        render_stats.sgp_peak = render_stats.sgp_vertices;
+    }
+    render_stats.sgp_overflows += render_stats_last.sgp_overflows;
+    render_stats_last = render_stats;
+    render_stats = (RenderStats) {0};
+}
+
+// below this many items a job costs more to hand out than it saves
+#define EXTRACT_MIN_PER_JOB 2048
+#define EXTRACT_MAX_JOBS (JOB_POOL_MAX_THREADS + 1)
+
+// scratch for splitting an extraction into jobs, only used on the simulation thread
+typedef struct {
+    SpriteExtractJob job;
+    void* ctx;
+    SpriteList* list;
+    int slots;                     // list slots reserved per item
+    int base;                      // where this extraction's sprites start in the list
+    int first[EXTRACT_MAX_JOBS];
+    int last[EXTRACT_MAX_JOBS];
+    int written[EXTRACT_MAX_JOBS];
+} ParallelExtract;
+
+static ParallelExtract parallel_extract = {0};
+
+// what the sprite jobs read, the entities of the visible grid chunks
+typedef struct {
+    AppState* state;
+    RenderLod lod;
+    float view[4];                 // x0, y0, x1, y1
+    ecs_entity_t* visible;         // stb_ds array
+} SpriteExtract;
+
+static SpriteExtract sprite_extract = {0};
+
+// low detail colours
+const uint8_t lod_belt_colour[4] = { 70, 70, 78, 255 };
+const uint8_t lod_item_colour[4] = { 214, 160, 84, 255 };
+static const uint8_t lod_other_colour[4] = { 90, 150, 220, 255 };
 void fps_counter_update(AppState* state) {
     fps_counter.frame_count++;
     
@@ -21,6 +77,37 @@ void fps_counter_update(AppState* state) {
     }
 }
 
+// moves entities between chunk buckets when they walk across a chunk border, and re-sorts
+// them in the isometric draw order. buildings never move, so only the things that do are visited
+void sync_grid_chunks(ecs_iter_t *it) {
+    AppState *state = ecs_get_ctx(it->world);
+    Position *pos = ecs_field(it, Position, 0);
+    GridChunkRef *ref = ecs_field(it, GridChunkRef, 1);
+    Sprite *spr = ecs_field(it, Sprite, 2);
+
+    for (int i = 0; i < it->count; i++) {
+        iso_render_moved(state, it->entities[i], &pos[i], &spr[i]);
+        int cx = world_to_chunk(pos[i].x);
+        int cy = world_to_chunk(pos[i].y);
+        if (cx != ref[i].chunk_x || cy != ref[i].chunk_y) {
+            grid_chunk_remove(state, ref[i].chunk_x, ref[i].chunk_y, it->entities[i]);
+            grid_chunk_add(state, cx, cy, it->entities[i]);
+            ref[i].chunk_x = cx;
+            ref[i].chunk_y = cy;
+        }
+    }
+}
+
+static void on_grid_chunk_ref_removed(ecs_iter_t *it) {
+    AppState *state = ecs_get_ctx(it->world);
+    GridChunkRef *ref = ecs_field(it, GridChunkRef, 0);
+
+    for (int i = 0; i < it->count; i++) {
+        grid_chunk_remove(state, ref[i].chunk_x, ref[i].chunk_y, it->entities[i]);
+        iso_render_untrack(state, it->entities[i]);
+    }
+}
+
 bool renderer_initialize(AppState* state) {
     if (!renderer_init(state)) {
         return false;
@@ -34,20 +121,31 @@ bool renderer_initialize(AppState* state) {
         .terms = {{ ecs_id(Position) }, { ecs_id(Sprite) }}
     });
 
-    // Updated: AnimationSet + AnimationState instead of SpriteAnimation + SpriteEntityRef
+    // the emitters, the particles themselves aren't entities
+    state->renderer.queries.particles = ecs_query(state->ecs, {
+        .terms = {{ ecs_id(Position) }, { ecs_id(ParticleEmitter) }}
+    });
+
+    ECS_SYSTEM(state->ecs, sync_grid_chunks, EcsPostUpdate, Position, GridChunkRef, Sprite, !Conveyor);
+    ecs_observer(state->ecs, {
+        .query.terms = {{ ecs_id(GridChunkRef) }},
+        .events = { EcsOnRemove },
+        .callback = on_grid_chunk_ref_removed
+    });
+
+    // entities only hold a handle, the sets themselves are shared per sprite type
     state->renderer.queries.animations = ecs_query(state->ecs, {
         .terms = {
-            { .id = ecs_id(AnimationSet) },
+            { .id = ecs_id(AnimationSetRef) },
             { .id = ecs_id(AnimationState) },
             { .id = ecs_id(Sprite) },
             { .id = ecs_id(Direction) }
         }
     });
 
-    // Updated: AnimationSet + AnimationState instead of SpriteAnimation
     state->renderer.queries.animation_graphs = ecs_query(state->ecs, {
         .terms = {
-            { .id = ecs_id(AnimationSet) },
+            { .id = ecs_id(AnimationSetRef) },
             { .id = ecs_id(AnimationState) },
             { .id = ecs_id(AnimationGraphComponent) }
         }
@@ -60,19 +158,23 @@ bool renderer_initialize(AppState* state) {
         }
     });
 
+    // draw calls per frame for render_stats
+    sg_enable_frame_stats();
+
+    state->renderer.surface_width = state->pixel_width;
+    state->renderer.surface_height = state->pixel_height;
+    render_scale_init(&state->renderer.scale, 1.0f, true, RENDER_SCALE_BUDGET);
+
     printf("creating shader");
     // Initialise shaders and pipelines here
-    state->renderer.sprite_shader = sg_make_shader(sgp_program_shader_desc(sg_query_backend()));
-    if (sg_query_shader_state(state->renderer.sprite_shader) != SG_RESOURCESTATE_VALID)
-    {
-        fprintf(stderr, "failed to make custom pipeline shader\n");
+    if (!sprite_batch_init(&state->renderer.sprites)) {
+        fprintf(stderr, "failed to make sprite pipeline\n");
+        exit(-1);
+    }
+    if (!particles_render_init(state)) {
+        fprintf(stderr, "failed to make particle pipeline\n");
         exit(-1);
     }
-    sgp_pipeline_desc pip_desc = {0};
-    pip_desc.shader = state->renderer.sprite_shader;
-    pip_desc.has_vs_color = true;
-    pip_desc.blend_mode = SGP_BLENDMODE_BLEND;
-    state->renderer.sprite_pipeline = sgp_make_pipeline(&pip_desc);
     return true;
 }
 
@@ -88,86 +190,552 @@ sg_swapchain renderer_get_swapchain(AppState* state) {
     return get_swapchain(state);
 }
 
-void renderer_draw_frame(void* appstate) {
-    AppState* state = (AppState*) appstate;
+// sokol_gp's command list size, and what's been queued on it since the last flush. counted
+// by renderer_sgp_room, only touched by the thread that draws
+static uint32_t sgp_command_capacity = RENDER_SGP_COMMANDS;
+static uint32_t sgp_flush_commands = 0;
+// what renderer_sgp_room had to skip quads for this frame
+static sgp_error sgp_short = SGP_NO_ERROR;
 
-    int width = state->width;
-    int height = state->height;
-    renderer_begin_frame(state);
-    sg_pass pass = {.swapchain = renderer_get_swapchain(state)};
-    sg_begin_pass(&pass);
-    sgp_begin(width, height);
-    sgp_project(0, (float)width, 0, (float)height);
+bool renderer_sgp_setup(AppState* state, uint32_t vertices, uint32_t commands) {
+    sgp_setup(&(sgp_desc) { .max_vertices = vertices, .max_commands = commands });
+    if (!sgp_is_valid()) {
+        return false;
+    }
+    state->renderer.sgp_vertices = vertices;
+    state->renderer.sgp_commands = commands;
+    sgp_command_capacity = commands;
+    return true;
+}
 
+void renderer_sgp_check(AppState* state) {
+    sgp_error error = sgp_get_last_error();
+    if (error != SGP_ERROR_VERTICES_FULL && error != SGP_ERROR_VERTICES_OVERFLOW &&
+        error != SGP_ERROR_COMMANDS_FULL) {
+        // sokol_gp itself was fine, but quads may have been skipped to keep it that way
+        error = sgp_short;
+    }
+    sgp_short = SGP_NO_ERROR;
+    sgp_flush_commands = 0;
+    if (error == SGP_NO_ERROR) {
+        return;
+    }
+    if (state->renderer.sgp_overflow == SGP_NO_ERROR) {
+        render_stats.sgp_overflows++;
+    }
+    state->renderer.sgp_overflow = error;
+}
+
+int renderer_sgp_room(int quads, uint32_t vertices_per_quad, uint32_t texture_binds) {
+    if (quads <= 0) {
+        return 0;
+    }
+    // a quad is at most one command, plus one for a scissor or viewport change
+    if (sgp_flush_commands + (uint32_t)quads + 1 > sgp_command_capacity) {
+        sgp_flush();
+        sgp_flush_commands = 0;
+    }
+    int fit = quads;
+    if ((uint32_t)fit + 1 > sgp_command_capacity) {
+        fit = (int)sgp_command_capacity - 1;
+        sgp_short = SGP_ERROR_COMMANDS_FULL;
+    }
+    uint32_t left = render_stats.sgp_capacity > render_stats.sgp_vertices ?
+                    render_stats.sgp_capacity - render_stats.sgp_vertices : 0;
+    if ((uint64_t)fit * vertices_per_quad > left) {
+        fit = (int)(left / vertices_per_quad);
+        sgp_short = SGP_ERROR_VERTICES_FULL;
+    }
+
+    sgp_flush_commands += (uint32_t)fit;
+    render_stats_count((uint32_t)fit * vertices_per_quad, fit > 0 ? texture_binds : 0);
+    render_stats.sgp_vertices += (uint32_t)fit * vertices_per_quad;
+    return fit;
+}
+
+// sokol_gp can't grow its buffers, so it's set up again with bigger ones. only between
+// frames, nothing of it may be in use. vertices is what this frame is about to queue. the
+// new size shows up in the stats (sgp_capacity)
+static void renderer_sgp_reserve(AppState* state, uint32_t vertices) {
+    Renderer* renderer = &state->renderer;
+    uint32_t want_vertices = renderer->sgp_vertices;
+    uint32_t want_commands = renderer->sgp_commands;
+    while (want_vertices < vertices) {
+        want_vertices *= 2;
+    }
+    // a miss means the count up front was short, don't trust it next time either
+    if (renderer->sgp_overflow == SGP_ERROR_COMMANDS_FULL) {
+        want_commands *= 2;
+    } else if (renderer->sgp_overflow != SGP_NO_ERROR && want_vertices == renderer->sgp_vertices) {
+        want_vertices *= 2;
+    }
+    renderer->sgp_overflow = SGP_NO_ERROR;
+    if (want_vertices == renderer->sgp_vertices && want_commands == renderer->sgp_commands) {
+        return;
+    }
+
+    uint32_t old_vertices = renderer->sgp_vertices;
+    uint32_t old_commands = renderer->sgp_commands;
+    sgp_shutdown();
+    if (renderer_sgp_setup(state, want_vertices, want_commands)) {
+        return;
+    }
+    fprintf(stderr, "failed to grow sokol_gp to %u vertices: %s\n", want_vertices,
+            sgp_get_error_message(sgp_get_last_error()));
+    sgp_shutdown();
+    renderer_sgp_setup(state, old_vertices, old_commands);
+}
+
+static int lod_rect(float x, float y, float w, float h, int layer, const uint8_t tint[4],
+                    SpriteInstance* out, uint64_t* key) {
+    sprite_instance_flat(x, y, w, h, layer, SPRITE_PAGE_SOLID, tint, out, key);
+    return 1;
+}
+
+// a belt at medium zoom: a flat tile plus one strip per lane, as long as the lane is full.
+// items pile up at the exit so the strips start there. writes up to LOD_LANE_SLOTS instances
+#define LOD_LANE_SLOTS (1 + CONVEYOR_LANES)
+static int lane_instances(float x, float y, float w, float h, const Conveyor* conv,
+                          SpriteInstance* out, uint64_t* keys) {
+    int n = lod_rect(x, y, w, h, RENDER_LAYER_BELTS, lod_belt_colour, &out[0], &keys[0]);
+
+    for (int lane = 0; lane < CONVEYOR_LANES; lane++) {
+        float fill = (float)conv->lane_item_count[lane] / MAX_CONVEYER_ITEMS;
+        if (fill <= 0.0f) {
+            continue;
+        }
+        if (fill > 1.0f) fill = 1.0f;
+
+        // same sides the items are spawned on, see entity_factory_spawn_conveyor_item
+        bool near_half;  // top half for horizontal belts, left half for vertical ones
+        switch (conv->dir) {
+            case DIR_UP:    near_half = lane == LANE_LEFT; break;
+            case DIR_DOWN:  near_half = lane != LANE_LEFT; break;
+            case DIR_RIGHT: near_half = lane != LANE_LEFT; break;
+            default:        near_half = lane == LANE_LEFT; break;
+        }
+
+        float sx, sy, sw, sh;
+        if (conv->dir == DIR_UP || conv->dir == DIR_DOWN) {
+            sw = w * 0.25f;
+            sh = h * fill;
+            sx = x + (near_half ? w * 0.125f : w * 0.625f);
+            sy = conv->dir == DIR_DOWN ? y + h - sh : y;
+        } else {
+            sw = w * fill;
+            sh = h * 0.25f;
+            sx = conv->dir == DIR_RIGHT ? x + w - sw : x;
+            sy = y + (near_half ? h * 0.125f : h * 0.625f);
+        }
+        n += lod_rect(sx, sy, sw, sh, RENDER_LAYER_ITEMS, lod_item_colour, &out[n], &keys[n]);
+    }
+    return n;
+}
+
+// builds the instances of one slice of the visible entities
+static int extract_sprites_job(void* ctx, int first, int last, SpriteInstance* out, uint64_t* keys) {
+    SpriteExtract* ex = (SpriteExtract*) ctx;
+    AppState* state = ex->state;
+    float view_x0 = ex->view[0], view_y0 = ex->view[1];
+    float view_x1 = ex->view[2], view_y1 = ex->view[3];
+
+    int written = 0;
+    for (int i = first; i < last; i++) {
+        ecs_entity_t e = ex->visible[i];
+        const Position* pos = ecs_get(state->ecs, e, Position);
+        const Sprite* spr = ecs_get(state->ecs, e, Sprite);
+        if (!pos || !spr) {
+            continue;
+        }
+
+        float w = spr->src_w * spr->scale_x;
+        float h = spr->src_h * spr->scale_y;
+        if (pos->x + w < view_x0 || pos->x > view_x1 || pos->y + h < view_y0 || pos->y > view_y1) {
+            continue;
+        }
+
+        // at medium zoom items only show up as their lane's fill strip
+        if (ex->lod == RENDER_LOD_LANES) {
+            if (ecs_has(state->ecs, e, ConveyorItem)) {
+                continue;
+            }
+            const Conveyor* conv = ecs_get(state->ecs, e, Conveyor);
+            if (conv) {
+                written += lane_instances(pos->x, pos->y, w, h, conv, &out[written], &keys[written]);
+                continue;
+            }
+        }
+
+        const RenderLayer* layer = ecs_get(state->ecs, e, RenderLayer);
+        const ShaderAnimation* anim = ecs_get(state->ecs, e, ShaderAnimation);
+        if (sprite_instance_make(&state->sprite_atlas, spr, pos->x, pos->y,
+                                 layer ? layer->layer : RENDER_LAYER_GROUND, anim ? anim->clip : 0,
+                                 &out[written], &keys[written])) {
+            written++;
+        }
+    }
+    return written;
+}
+
+static void parallel_extract_job(void* ctx, int job) {
+    ParallelExtract* px = (ParallelExtract*) ctx;
+    int slot = px->base + px->first[job] * px->slots;
+    px->written[job] = px->job(px->ctx, px->first[job], px->last[job],
+                               &px->list->instances[slot], &px->list->keys[slot]);
+}
+
+void renderer_extract_parallel(AppState* state, SpriteList* list, int count, int slots,
+                               SpriteExtractJob job, void* ctx) {
+    if (count == 0) {
+        return;
+    }
+    ParallelExtract* px = &parallel_extract;
+
+    // every item gets its slots, so each job writes its own slice of the list without locking
+    int jobs = count / EXTRACT_MIN_PER_JOB;
+    if (jobs > job_pool_width(&state->jobs)) jobs = job_pool_width(&state->jobs);
+    if (jobs > EXTRACT_MAX_JOBS) jobs = EXTRACT_MAX_JOBS;
+    if (jobs < 1) jobs = 1;
+    for (int j = 0; j < jobs; j++) {
+        px->first[j] = (int)((long long)count * j / jobs);
+        px->last[j] = (int)((long long)count * (j + 1) / jobs);
+    }
+
+    px->job = job;
+    px->ctx = ctx;
+    px->list = list;
+    px->slots = slots;
+    px->base = (int)arrlen(list->instances);
+    arrsetlen(list->instances, px->base + count * slots);
+    arrsetlen(list->keys, px->base + count * slots);
+
+    // the world is read only while the jobs run, flecs only allows reads from several
+    // threads in that mode
+    ecs_readonly_begin(state->ecs, true);
+    job_pool_run(&state->jobs, jobs, parallel_extract_job, px);
+    ecs_readonly_end(state->ecs);
+
+    // culled items leave gaps at the end of each slice, close them up in order
+    int written = px->base;
+    for (int j = 0; j < jobs; j++) {
+        int start = px->base + px->first[j] * slots;
+        if (start != written) {
+            memmove(&list->instances[written], &list->instances[start],
+                    (size_t)px->written[j] * sizeof(SpriteInstance));
+            memmove(&list->keys[written], &list->keys[start], (size_t)px->written[j] * sizeof(uint64_t));
+        }
+        written += px->written[j];
+    }
+    arrsetlen(list->instances, written);
+    arrsetlen(list->keys, written);
+}
+
+// recounts a chunk's contents and picks its far zoom colour: belts, items and anything
+// else each pull towards their own colour, more of them means a brighter tile
+static void update_chunk_lod(AppState* state, ChunkLod* lod, ecs_entity_t* entities) {
+    lod->belts = lod->items = lod->others = 0;
+    for (int i = 0; i < arrlen(entities); i++) {
+        if (ecs_has(state->ecs, entities[i], Conveyor)) lod->belts++;
+        else if (ecs_has(state->ecs, entities[i], ConveyorItem)) lod->items++;
+        else lod->others++;
+    }
+    lod->dirty = false;
+
+    int total = lod->belts + lod->items + lod->others;
+    if (total == 0) {
+        lod->colour[3] = 0;
+        return;
+    }
+
+    float tiles = GRID_CHUNK_SIZE * GRID_CHUNK_SIZE;
+    float density = 0.35f + 0.65f * fminf(1.0f, total / tiles);
+    for (int c = 0; c < 3; c++) {
+        float mix = (lod_belt_colour[c] * lod->belts + lod_item_colour[c] * lod->items +
+                     lod_other_colour[c] * lod->others) / (float)total;
+        lod->colour[c] = (uint8_t)(mix * density);
+    }
+    lod->colour[3] = 255;
+}
+
+// far zoom: one tile per grid chunk that has anything in it. on isometric maps the tile is
+// the chunk's diamond, and chunks whose diamond misses the view are skipped
+static void extract_chunk_tiles(AppState* state, RenderPacket* packet, int chunk_x0, int chunk_y0,
+                                int chunk_x1, int chunk_y1) {
+    float size = TILE_SIZE * GRID_CHUNK_SIZE;
+    bool isometric = state->map.tiles.isometric;
+    const float* view = packet->view;
+
+    for (int cy = chunk_y0; cy <= chunk_y1; cy++) {
+        for (int cx = chunk_x0; cx <= chunk_x1; cx++) {
+            ChunkLod* lod = grid_chunk_lod(state, cx, cy);
+            if (!lod) {
+                continue;
+            }
+            float tile[4] = { cx * size, cy * size, size, size };
+            if (isometric) {
+                map_grid_rect_to_iso(&state->map, tile[0], tile[1], size, size, tile);
+                if (tile[0] + tile[2] < view[0] || tile[0] > view[0] + view[2] ||
+                    tile[1] + tile[3] < view[1] || tile[1] > view[1] + view[3]) {
+                    continue;
+                }
+            }
+            if (lod->dirty) {
+                update_chunk_lod(state, lod, grid_chunk_entities(state, cx, cy));
+            }
+            if (lod->colour[3] == 0) {
+                continue;
+            }
+            if (isometric) {
+                sprite_list_push_diamond(&packet->sprites, tile[0], tile[1], tile[2], tile[3],
+                                         RENDER_LAYER_BELTS, lod->colour);
+            } else {
+                sprite_list_push_rect(&packet->sprites, tile[0], tile[1], tile[2], tile[3],
+                                      RENDER_LAYER_BELTS, lod->colour);
+            }
+        }
+    }
+}
+
+// copies everything visible this frame into the packet. runs on the simulation thread and
+// is the only part of drawing that reads the ecs
+void renderer_extract_frame(AppState* state, RenderPacket* packet) {
+    render_packet_clear(packet);
+    packet->width = state->width;
+    packet->height = state->height;
+    packet->pixel_width = state->pixel_width;
+    packet->pixel_height = state->pixel_height;
+    packet->dt = state->delta_time;
+    render_scale_update(&state->renderer.scale, state->delta_time);
+    packet->render_scale = state->renderer.scale.current;
+    packet->capture = state->capture_mode;
+    ui_set_text(&state->ui, state->fps_label, fps_counter.fps_text);
+    ui_extract(state, packet);
+
+    // everything in the world is drawn through the camera
+    float view_x0, view_y0, view_x1, view_y1;
+    camera_view_bounds(&state->camera, &view_x0, &view_y0, &view_x1, &view_y1);
+    packet->view[0] = view_x0;
+    packet->view[1] = view_y0;
+    packet->view[2] = view_x1 - view_x0;
+    packet->view[3] = view_y1 - view_y0;
+
+    // isometric maps are drawn on the diamond plane, entities get projected onto it. the view
+    // then covers a rotated patch of the build grid
+    bool isometric = state->map.tiles.isometric;
+    float corners[4][2] = { { view_x0, view_y0 }, { view_x1, view_y0 }, { view_x1, view_y1 }, { view_x0, view_y1 } };
+    for (int i = 0; i < 4; i++) {
+        if (isometric) {
+            map_iso_to_grid(&state->map, corners[i][0], corners[i][1], &packet->ground[i][0], &packet->ground[i][1]);
+        } else {
+            packet->ground[i][0] = corners[i][0];
+            packet->ground[i][1] = corners[i][1];
+        }
+    }
+
+    tilemap_render_extract(state, packet);
+    minimap_extract(state, packet);
+    particles_extract(&state->particles, packet->view, &packet->particles);
 
-    // draw background tiles when we start loading them in
-    //draw_background_tiles(renderer->queries.background_tiles);
-    
     // draw entities on ground when we start tracking the entities
     // draw_ground_entities(renderer->queries.ground_entities);
 
     // draw sprites / shapes
-    //sgp_set_pipeline(state->renderer.sprite_pipeline);
     ecs_iter_t it = ecs_query_iter(state->ecs, state->renderer.queries.ground_entities);
      while (ecs_query_next(&it)) {
         Position *pos = ecs_field(&it, Position, 0);
         Colour *col = ecs_field(&it, Colour, 1);
         
         for (int i = 0; i < it.count; i++) {
-            sgp_set_color(col[i].r, col[i].g, col[i].b, col[i].a);
-            sgp_draw_filled_rect(pos[i].x, pos[i].y, 50, 50);
+            float x = pos[i].x, y = pos[i].y;
+            if (isometric) {
+                // centred on where the square's centre lands
+                map_grid_to_iso(&state->map, x + 25, y + 25, &x, &y);
+                x -= 25;
+                y -= 25;
+            }
+            if (x + 50 < view_x0 || x > view_x1 || y + 50 < view_y0 || y > view_y1) {
+                continue;
+            }
+            arrput(packet->rects, ((RenderRect) { x, y, 50, 50, { col[i].r, col[i].g, col[i].b, col[i].a } }));
         }
     }
 
-    it = ecs_query_iter(state->ecs, state->renderer.queries.sprites);
-    sgp_set_blend_mode(SGP_BLENDMODE_BLEND);
-     while (ecs_query_next(&it)) {
-        Position *pos = ecs_field(&it, Position, 0);
-        Sprite* spr = ecs_field(&it, Sprite, 1);
-        
-        for (int i = 0; i < it.count; i++) {
-            sgp_set_color(1.0f, 1.0f, 1.0f, 1.0f);
-            sgp_set_image(0, spr[i].texture);
-            
-            sgp_push_transform();
-            sgp_translate(pos[i].x, pos[i].y);
-            sgp_rotate(spr[i].rotation);
-            sgp_scale(spr[i].scale_x, spr[i].scale_y);
-            
-            sgp_rect src = {spr[i].src_x, spr[i].src_y, spr[i].src_w, spr[i].src_h};
-            sgp_rect dst = {0, 0, spr[i].src_w, spr[i].src_h};  // Keep this at base size
-            sgp_draw_textured_rect(0, dst, src);
-            
-            sgp_pop_transform();
+    // sprites are gathered into one instance record each and drawn by the sprite batch,
+    // which sorts them by layer, page and depth. only chunks overlapping the view are visited, sprites can
+    // hang over the edge of their chunk (the player is 64px) so one extra ring is included.
+    // on isometric maps that's the patch of the grid under the view's corners
+    float grid_x0 = view_x0, grid_y0 = view_y0, grid_x1 = view_x1, grid_y1 = view_y1;
+    if (isometric) {
+        grid_x0 = grid_x1 = packet->ground[0][0];
+        grid_y0 = grid_y1 = packet->ground[0][1];
+        for (int i = 1; i < 4; i++) {
+            grid_x0 = fminf(grid_x0, packet->ground[i][0]);
+            grid_x1 = fmaxf(grid_x1, packet->ground[i][0]);
+            grid_y0 = fminf(grid_y0, packet->ground[i][1]);
+            grid_y1 = fmaxf(grid_y1, packet->ground[i][1]);
         }
     }
+    int chunk_x0 = world_to_chunk(grid_x0) - 1, chunk_x1 = world_to_chunk(grid_x1);
+    int chunk_y0 = world_to_chunk(grid_y0) - 1, chunk_y1 = world_to_chunk(grid_y1);
 
-    // draw text
-    // Draw FPS counter in top-left corner
-    text_renderer_draw_text(state->renderer.text_renderer, state->font[0], fps_counter.fps_text, 
-                            0, 0, 1.0f, (float[4])SG_WHITE, TEXT_ANCHOR_TOP_LEFT);
+    // zoomed far out every chunk is a single tile, whatever is in it
+    RenderLod lod = camera_lod(&state->camera);
+    if (lod == RENDER_LOD_CHUNKS) {
+        extract_chunk_tiles(state, packet, chunk_x0, chunk_y0, chunk_x1, chunk_y1);
+    }
+
+    // the depth order already has everything in draw order, and has its own lod. the chunk
+    // tiles lie on the ground, underneath all of it
+    if (isometric) {
+        iso_render_extract(state, packet, lod);
+        return;
+    }
+    if (lod == RENDER_LOD_CHUNKS) {
+        return;
+    }
+
+    SpriteExtract* ex = &sprite_extract;
+    arrsetlen(ex->visible, 0);
+    for (int cy = chunk_y0; cy <= chunk_y1; cy++) {
+        for (int cx = chunk_x0; cx <= chunk_x1; cx++) {
+            ecs_entity_t* entities = grid_chunk_entities(state, cx, cy);
+            if (arrlen(entities) > 0) {
+                memcpy(arraddnptr(ex->visible, arrlen(entities)), entities, arrlen(entities) * sizeof(ecs_entity_t));
+            }
+        }
+    }
+
+    ex->state = state;
+    ex->lod = lod;
+    ex->view[0] = view_x0;
+    ex->view[1] = view_y0;
+    ex->view[2] = view_x1;
+    ex->view[3] = view_y1;
+    renderer_extract_parallel(state, &packet->sprites, (int)arrlen(ex->visible),
+                              lod == RENDER_LOD_LANES ? LOD_LANE_SLOTS : 1, extract_sprites_job, ex);
+}
 
-    text_renderer_draw_text(state->renderer.text_renderer, state->font[1], "WORK IN PROGRESS", 
-    width / 2, 0, 1.0f, (float[4])SG_WHITE, TEXT_ANCHOR_TOP_CENTER);
+// the map, entities and sprites, into whichever pass is open
+static void draw_world(AppState* state, RenderPacket* packet) {
+    const float* view = packet->view;
+    sgp_project(view[0], view[0] + view[2], view[1], view[1] + view[3]);
+
+    // static map layers, straight from their baked chunk buffers. sokol_gp only submits at
+    // flush, so these land underneath everything it draws
+    tilemap_render_draw(state, packet);
+
+    // asked for in batches, so the command list gets flushed between them
+    int rect_count = (int)arrlen(packet->rects);
+    for (int first = 0; first < rect_count; first += RENDER_SGP_FLUSH_QUADS) {
+        int count = rect_count - first < RENDER_SGP_FLUSH_QUADS ? rect_count - first : RENDER_SGP_FLUSH_QUADS;
+        count = renderer_sgp_room(count, 6, 0);
+        for (int i = first; i < first + count; i++) {
+            const RenderRect* r = &packet->rects[i];
+            sgp_set_color(r->colour[0], r->colour[1], r->colour[2], r->colour[3]);
+            sgp_draw_filled_rect(r->x, r->y, r->w, r->h);
+        }
+    }
+
+    // whatever sokol_gp has queued goes first so the sprites land on top of it
+    sgp_flush();
+    sprite_batch_advance(&state->renderer.sprites, packet->dt);
+    sprite_batch_draw(&state->renderer.sprites, &state->sprite_atlas, &packet->sprites, view);
+    particles_draw(state, packet->particles, (int)arrlen(packet->particles), view);
+}
+
+// draws an extracted packet. runs on whichever thread owns the gpu context and only reads
+// the packet and renderer state, never the ecs
+void renderer_submit_frame(AppState* state, RenderPacket* packet) {
+    int width = packet->width;
+    int height = packet->height;
+    int pixel_width = packet->pixel_width;
+    int pixel_height = packet->pixel_height;
+    if (pixel_width != state->renderer.surface_width || pixel_height != state->renderer.surface_height) {
+        renderer_resize(state, pixel_width, pixel_height);
+    }
+
+    renderer_begin_frame(state);
+
+    // everything sokol_gp will be handed this frame, counted before any of it is queued
+    uint32_t ui_quads = (uint32_t)arrlen(packet->ui_quads);
+    if (ui_quads < (uint32_t)arrlen(state->renderer.ui.quads)) {
+        ui_quads = (uint32_t)arrlen(state->renderer.ui.quads);
+    }
+    renderer_sgp_reserve(state, 6 * ((uint32_t)arrlen(packet->rects) + ui_quads) + RENDER_SGP_OVERLAY_VERTICES);
+    render_stats.sgp_capacity = state->renderer.sgp_vertices;
+
+    minimap_upload(state, packet);
+    ui_render(state, packet);
+
+    // below full scale the world is drawn small first, then stretched over the backbuffer
+    SceneTarget* scene = &state->renderer.scene;
+    bool scaled = false;
+    if (packet->render_scale < 1.0f) {
+        int scene_width = (int)(pixel_width * packet->render_scale + 0.5f);
+        int scene_height = (int)(pixel_height * packet->render_scale + 0.5f);
+        if (scene_width < 1) scene_width = 1;
+        if (scene_height < 1) scene_height = 1;
+        scaled = scene_target_resize(scene, scene_width, scene_height);
+    }
+    if (scaled) {
+        sg_begin_pass(&(sg_pass) {
+            .action.colors[0] = { .load_action = SG_LOADACTION_CLEAR, .clear_value = { 0.0f, 0.0f, 0.0f, 1.0f } },
+            .attachments = scene->pass
+        });
+        sgp_begin(scene->width, scene->height);
+        draw_world(state, packet);
+        sgp_flush();
+        sgp_end();
+        renderer_sgp_check(state);
+        sg_end_pass();
+    }
+
+    sg_pass pass = {.swapchain = renderer_get_swapchain(state)};
+    sg_begin_pass(&pass);
+    sgp_begin(pixel_width, pixel_height);
+
+    if (scaled) {
+        scene_target_draw(scene, (float)pixel_width, (float)pixel_height);
+    } else {
+        draw_world(state, packet);
+    }
+
+    // ui is drawn at full resolution, laid out in window coordinates
+    sgp_project(0.0f, (float)width, 0.0f, (float)height);
+
+    ui_draw(state, packet);
+    minimap_draw(state, packet);
 
     sgp_flush();
     sgp_end();
+    renderer_sgp_check(state);
     sg_end_pass();
     sg_commit();
+    render_stats_end_frame();
+    frame_capture_frame(&state->renderer.capture, packet->capture, renderer_get_swapchain(state));
     renderer_end_frame(state);
 }
 
+void renderer_draw_frame(void* appstate) {
+    AppState* state = (AppState*) appstate;
+
+    // drawn by the render thread if it is running, inline otherwise
+    renderer_extract_frame(state, render_thread_packet(state));
+    render_thread_submit(state);
+}
+
 void update_animations(AppState *state, float dt) {
     ecs_iter_t it = ecs_query_iter(state->ecs, state->renderer.queries.animations);
    
     while (ecs_query_next(&it)) {
-        AnimationSet *anim_set = ecs_field(&it, AnimationSet, 0);
+        AnimationSetRef *set_ref = ecs_field(&it, AnimationSetRef, 0);
         AnimationState *anim_state = ecs_field(&it, AnimationState, 1);
         Sprite *sprite = ecs_field(&it, Sprite, 2);
         Direction *dir = ecs_field(&it, Direction, 3);
         
         for (int i = 0; i < it.count; i++) {
-            AnimationClip *clip = &anim_set[i].clips[anim_state[i].current_clip];
+            const AnimationSet *anim_set = &state->animation_sets[set_ref[i].set];
+            const AnimationClip *clip = &anim_set->clips[anim_state[i].current_clip];
             
             anim_state[i].elapsed += dt;
             
@@ -182,52 +750,75 @@ void update_animations(AppState *state, float dt) {
                 int row = clip->direction_count > 1 ? dir[i] : 
                          (clip->row >= 0 ? clip->row : 0);
                 
-                sprite[i].src_x = anim_state[i].current_frame * anim_set[i].width;
-                sprite[i].src_y = row * anim_set[i].height;
+                // the graph system may have switched clips, which can live on another page
+                sprite[i].texture = clip->texture;
+                sprite[i].src_x = clip->atlas_x + anim_state[i].current_frame * anim_set->width;
+                sprite[i].src_y = clip->atlas_y + row * anim_set->height;
             }
         }
     }
 }
 
-void set_sprite_animation(ecs_world_t *world, ecs_entity_t entity, const char *anim_name) {
-    const AnimationSet *anim_set = ecs_get(world, entity, AnimationSet);
+void set_sprite_clip(ecs_world_t *world, ecs_entity_t entity, int clip_index) {
+    AppState *state = ecs_get_ctx(world);
+    const AnimationSetRef *set_ref = ecs_get(world, entity, AnimationSetRef);
     AnimationState *anim_state = ecs_get_mut(world, entity, AnimationState);
+    ShaderAnimation *shader_anim = ecs_get_mut(world, entity, ShaderAnimation);
     Sprite *sprite = ecs_get_mut(world, entity, Sprite);
     const Direction *dir = ecs_get(world, entity, Direction);
    
-    if (!anim_set || !anim_state || !sprite) {
+    if (!set_ref || (!anim_state && !shader_anim) || !sprite) {
         fprintf(stderr, "Entity missing required components\n");
         return;
     }
+    const AnimationSet *anim_set = &state->animation_sets[set_ref->set];
+    if (clip_index < 0 || clip_index >= anim_set->clip_count) {
+        return;
+    }
+    const AnimationClip *clip = &anim_set->clips[clip_index];
+   
+    // Determine row based on animation type
+    int row = 0;
+    if (clip->direction_count > 1) {
+        // If Direction is just the enum, dereference the pointer directly
+        row = dir ? *dir : 2;  // Just *dir, not dir->direction
+    } else if (clip->row >= 0) {
+        row = clip->row;
+    }
+   
+    // Update sprite texture and source rect IMMEDIATELY
+    sprite->texture = clip->texture;
+    sprite->src_x = clip->atlas_x;
+    sprite->src_y = clip->atlas_y + row * anim_set->height;
+   
+    // Update animation state, shader animated sprites only need to know the clip
+    if (anim_state) {
+        anim_state->current_clip = clip_index;
+        anim_state->current_frame = 0;
+        anim_state->elapsed = 0;
+    }
+    if (shader_anim) {
+        shader_anim->clip = clip->shader_clip;
+    }
+}
+
+void set_sprite_animation(ecs_world_t *world, ecs_entity_t entity, const char *anim_name) {
+    AppState *state = ecs_get_ctx(world);
+    const AnimationSetRef *set_ref = ecs_get(world, entity, AnimationSetRef);
+    if (!set_ref) {
+        fprintf(stderr, "Entity missing required components\n");
+        return;
+    }
+    const AnimationSet *anim_set = &state->animation_sets[set_ref->set];
    
     // Find the animation by name
     for (int i = 0; i < anim_set->clip_count; i++) {
         if (strcmp(anim_set->clip_names[i], anim_name) == 0) {
-            const AnimationClip *clip = &anim_set->clips[i];
-           
-            // Determine row based on animation type
-            int row = 0;
-            if (clip->direction_count > 1) {
-                // If Direction is just the enum, dereference the pointer directly
-                row = dir ? *dir : 2;  // Just *dir, not dir->direction
-            } else if (clip->row >= 0) {
-                row = clip->row;
-            }
-           
-            // Update sprite texture and source rect IMMEDIATELY
-            sprite->texture = clip->texture;
-            sprite->src_x = 0;
-            sprite->src_y = row * anim_set->height;
-           
-            // Update animation state
-            anim_state->current_clip = i;
-            anim_state->current_frame = 0;
-            anim_state->elapsed = 0;
-           
-            printf("Changed animation to: %s (clip %d, row: %d)\n", anim_name, i, row);
+            set_sprite_clip(world, entity, i);
+            printf("Changed animation to: %s (clip %d)\n", anim_name, i);
             return;
         }
     }
    
     fprintf(stderr, "Animation '%s' not found in entity's AnimationSet\n", anim_name);
-}
\ No newline at end of file
+}
@@ -29,6 +29,10 @@ typedef struct {
 
 extern fps_counter_t fps_counter;
 
+// low detail colours, belts and what's on them
+extern const uint8_t lod_belt_colour[4];
+extern const uint8_t lod_item_colour[4];
+
 typedef struct {
     SDL_Window* window;
     void* native_context;
@@ -53,12 +57,40 @@ void renderer_resize(void* appstate, int width, int height);
 void fps_counter_update(AppState* state);
 bool renderer_initialize(AppState* state);
 void renderer_draw_frame(void* appstate);
+void renderer_extract_frame(AppState* state, RenderPacket* packet);
+// one job's share of a parallel extraction: items first to last into out and keys, which
+// have room for every item's slots. returns how many instances it wrote
+typedef int (*SpriteExtractJob)(void* ctx, int first, int last, SpriteInstance* out, uint64_t* keys);
+// splits count items across the job pool and appends what the jobs write to list, in item
+// order. the world is read only while they run, so jobs can use ecs_get
+void renderer_extract_parallel(AppState* state, SpriteList* list, int count, int slots,
+                               SpriteExtractJob job, void* ctx);
+void renderer_submit_frame(AppState* state, RenderPacket* packet);
+// move the gpu context between threads, no-ops where the context isn't thread bound
+void renderer_acquire_context(AppState* state);
+void renderer_release_context(AppState* state);
 void update_animations(AppState *state, float dt);
 void set_sprite_animation(ecs_world_t *world, ecs_entity_t entity, const char *anim_name);
+// same, by index into the entity's AnimationSet, no name lookup
+void set_sprite_clip(ecs_world_t *world, ecs_entity_t entity, int clip_index);
 sg_swapchain renderer_get_swapchain(AppState* state);
 sg_swapchain get_swapchain(AppState* state);
 void load_spritesheet(void* appstate, char* file); // loads a spritesheet
 
+#ifdef RENDER_HEADLESS
+// offscreen runs for golden images and benchmarks, see backends/headless_backend.c
+typedef struct {
+    int frames;               // quit after this many, 0 runs until closed
+    int capture_frame;        // frame written to capture_path, -1 for none
+    const char* capture_path;
+    bool print_stats;         // draw calls, vertices and texture binds every frame
+    FrameCaptureMode record;  // every frame to captures/, see frame_capture.h
+} HeadlessOptions;
+
+extern HeadlessOptions headless_options;
+void headless_parse_args(int argc, char* argv[]);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,146 @@
+#include "render_thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "common.h"
+#include "systems/render_system.h"
+#include "util/stb_ds.h"
+
+void render_packet_clear(RenderPacket* packet) {
+    sprite_list_clear(&packet->sprites);
+    arrsetlen(packet->rects, 0);
+    arrsetlen(packet->particles, 0);
+    arrsetlen(packet->ui_quads, 0);
+    packet->ui_full = false;
+    arrsetlen(packet->map_chunks, 0);
+    // bakes are uploaded (and their instances freed) by the renderer, a packet that was
+    // never drawn still owns them
+    for (int i = 0; i < arrlen(packet->map_bakes); i++) {
+        arrfree(packet->map_bakes[i].instances);
+        arrfree(packet->map_bakes[i].runs);
+    }
+    arrsetlen(packet->map_bakes, 0);
+    for (int i = 0; i < arrlen(packet->minimap_uploads); i++) {
+        free(packet->minimap_uploads[i].pixels);
+    }
+    arrsetlen(packet->minimap_uploads, 0);
+}
+
+void render_packet_free(RenderPacket* packet) {
+    render_packet_clear(packet);
+    sprite_list_free(&packet->sprites);
+    arrfree(packet->rects);
+    arrfree(packet->particles);
+    arrfree(packet->ui_quads);
+    arrfree(packet->map_chunks);
+    arrfree(packet->map_bakes);
+    arrfree(packet->minimap_uploads);
+}
+
+static int render_thread_main(void* data) {
+    AppState* state = (AppState*) data;
+    RenderThread* rt = &state->renderer.thread;
+
+    for (;;) {
+        SDL_LockMutex(rt->lock);
+        while (!rt->pending && !rt->quit) {
+            SDL_WaitCondition(rt->cond, rt->lock);
+        }
+        if (!rt->pending) {
+            SDL_UnlockMutex(rt->lock);
+            break;
+        }
+        RenderPacket* packet = rt->pending;
+        rt->pending = NULL;
+        rt->drawing = true;
+        SDL_UnlockMutex(rt->lock);
+
+        renderer_submit_frame(state, packet);
+
+        SDL_LockMutex(rt->lock);
+        rt->drawing = false;
+        SDL_BroadcastCondition(rt->cond);
+        SDL_UnlockMutex(rt->lock);
+    }
+
+    renderer_release_context(state);
+    return 0;
+}
+
+bool render_thread_start(AppState* state) {
+    RenderThread* rt = &state->renderer.thread;
+
+#ifdef __APPLE__
+    // cocoa only lets the main thread present the window and drive its gl context, so on
+    // macos frames stay on the main thread
+    (void)rt;
+    return false;
+#endif
+
+    rt->lock = SDL_CreateMutex();
+    rt->cond = SDL_CreateCondition();
+    if (!rt->lock || !rt->cond) {
+        fprintf(stderr, "Failed to create render thread sync: %s, drawing on the main thread\n", SDL_GetError());
+        return false;
+    }
+
+    // a gl context can only be current on one thread at a time
+    renderer_release_context(state);
+    rt->thread = SDL_CreateThread(render_thread_main, "render", state);
+    if (!rt->thread) {
+        fprintf(stderr, "Failed to create render thread: %s, drawing on the main thread\n", SDL_GetError());
+        renderer_acquire_context(state);
+        return false;
+    }
+
+    rt->running = true;
+    return true;
+}
+
+void render_thread_stop(AppState* state) {
+    RenderThread* rt = &state->renderer.thread;
+
+    if (rt->running) {
+        // the packet in flight is drawn, then the thread lets go of the context
+        SDL_LockMutex(rt->lock);
+        rt->quit = true;
+        SDL_BroadcastCondition(rt->cond);
+        SDL_UnlockMutex(rt->lock);
+        SDL_WaitThread(rt->thread, NULL);
+        rt->thread = NULL;
+        rt->running = false;
+        renderer_acquire_context(state);
+    }
+
+    if (rt->cond) SDL_DestroyCondition(rt->cond);
+    if (rt->lock) SDL_DestroyMutex(rt->lock);
+    rt->cond = NULL;
+    rt->lock = NULL;
+
+    render_packet_free(&rt->packets[0]);
+    render_packet_free(&rt->packets[1]);
+}
+
+RenderPacket* render_thread_packet(AppState* state) {
+    RenderThread* rt = &state->renderer.thread;
+    return &rt->packets[rt->write];
+}
+
+void render_thread_submit(AppState* state) {
+    RenderThread* rt = &state->renderer.thread;
+    RenderPacket* packet = &rt->packets[rt->write];
+
+    if (!rt->running) {
+        renderer_submit_frame(state, packet);
+        return;
+    }
+
+    // once this returns the other packet is free to extract into
+    SDL_LockMutex(rt->lock);
+    while (rt->pending || rt->drawing) {
+        SDL_WaitCondition(rt->cond, rt->lock);
+    }
+    rt->pending = packet;
+    rt->write ^= 1;
+    SDL_BroadcastCondition(rt->cond);
+    SDL_UnlockMutex(rt->lock);
+}
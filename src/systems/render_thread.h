@@ -0,0 +1,74 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include "systems/sprite_batch.h"
+#include "util/tilemap.h"
+#include "systems/minimap.h"
+#include "systems/particles.h"
+#include "systems/frame_capture.h"
+#include "systems/ui.h"
+
+// the renderer never reads the ecs. each frame the simulation copies what is visible into a
+// packet (renderer_extract_frame) and a render thread that owns the gpu context submits it
+// while the simulation works on the next one. two packets, so extraction of frame N+1 can
+// run while frame N is drawn
+
+struct AppState;
+
+// entities drawn as flat coloured squares (Position + Colour)
+typedef struct {
+    float x, y, w, h;
+    float colour[4];
+} RenderRect;
+
+typedef struct RenderPacket {
+    int width, height;        // window size the frame is drawn at
+    int pixel_width, pixel_height;  // backbuffer size
+    float render_scale;       // fraction of the backbuffer the world is drawn at
+    FrameCaptureMode capture; // recording, see frame_capture.h
+    float view[4];            // visible world rect, x0, y0, width, height
+    float ground[4][2];       // the view's corners on the build grid, outlined on the minimap
+    float dt;                 // advances the shader animation clock
+    SpriteList sprites;
+    RenderRect* rects;        // stb_ds array
+    ParticleInstance* particles;  // stb_ds array
+    int* map_chunks;          // tile map chunks overlapping the view, stb_ds array
+    MapChunkBake* map_bakes;  // chunks rebaked this frame, stb_ds array
+    MinimapUpload* minimap_uploads;  // stb_ds array
+    UiQuad* ui_quads;         // the whole ui, only filled when it changed. stb_ds array
+    uint32_t ui_version;      // matches the renderer's cache when nothing changed
+    float ui_dirty[4];        // window rect to redraw, x, y, w, h
+    bool ui_full;             // redraw all of it
+} RenderPacket;
+
+typedef struct {
+    SDL_Thread* thread;
+    SDL_Mutex* lock;
+    SDL_Condition* cond;
+    RenderPacket packets[2];
+    int write;                // packet the simulation extracts into next
+    RenderPacket* pending;    // submitted but not picked up yet
+    bool drawing;
+    bool quit;
+    bool running;             // false means frames are drawn inline on the main thread
+} RenderThread;
+
+// hands the gpu context over to a new render thread. has to run after everything that
+// creates gpu resources at startup (atlas, map, fonts). falls back to drawing inline if the
+// thread can't be created, and always on macos where presenting has to stay on the main thread
+bool render_thread_start(struct AppState* state);
+// waits for the frame in flight and takes the context back, so shutdown can free resources
+void render_thread_stop(struct AppState* state);
+
+// the packet to extract the next frame into
+RenderPacket* render_thread_packet(struct AppState* state);
+// queues the extracted packet. blocks until the previous frame has been drawn, so the
+// simulation is never more than one frame ahead
+void render_thread_submit(struct AppState* state);
+
+void render_packet_clear(RenderPacket* packet);
+void render_packet_free(RenderPacket* packet);
+
+#endif
@@ -0,0 +1,341 @@
+#include "sprite_batch.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "shader.glsl.h"
+#include "util/stb_ds.h"
+#include "util/radix_sort.h"
+#include "systems/render_stats.h"
+
+static bool make_instance_buffer(SpriteBatch* batch, int capacity) {
+    if (batch->buffer.id != SG_INVALID_ID) {
+        sg_destroy_buffer(batch->buffer);
+    }
+    batch->buffer = sg_make_buffer(&(sg_buffer_desc) {
+        .size = (size_t)capacity * sizeof(SpriteInstance),
+        .usage = { .vertex_buffer = true, .stream_update = true },
+        .label = "sprite-instances"
+    });
+    batch->capacity = capacity;
+    return sg_query_buffer_state(batch->buffer) == SG_RESOURCESTATE_VALID;
+}
+
+bool sprite_batch_init(SpriteBatch* batch) {
+    memset(batch, 0, sizeof(SpriteBatch));
+
+    batch->shader = sg_make_shader(sgp_sprite_shader_desc(sg_query_backend()));
+    if (sg_query_shader_state(batch->shader) != SG_RESOURCESTATE_VALID) {
+        fprintf(stderr, "failed to make sprite shader\n");
+        return false;
+    }
+
+    // a single instance-rate buffer, the corners come from the vertex index
+    batch->pipeline = sg_make_pipeline(&(sg_pipeline_desc) {
+        .shader = batch->shader,
+        .layout = {
+            .buffers[0] = { .stride = sizeof(SpriteInstance), .step_func = SG_VERTEXSTEP_PER_INSTANCE },
+            .attrs = {
+                [ATTR_sprite_inst_pos] = { .offset = offsetof(SpriteInstance, x), .format = SG_VERTEXFORMAT_FLOAT2 },
+                [ATTR_sprite_inst_size] = { .offset = offsetof(SpriteInstance, w), .format = SG_VERTEXFORMAT_FLOAT2 },
+                [ATTR_sprite_inst_uv] = { .offset = offsetof(SpriteInstance, uv), .format = SG_VERTEXFORMAT_USHORT4N },
+                [ATTR_sprite_inst_rot] = { .offset = offsetof(SpriteInstance, rotation), .format = SG_VERTEXFORMAT_FLOAT },
+                [ATTR_sprite_inst_tint] = { .offset = offsetof(SpriteInstance, tint), .format = SG_VERTEXFORMAT_UBYTE4N },
+                [ATTR_sprite_inst_anim] = { .offset = offsetof(SpriteInstance, anim_clip), .format = SG_VERTEXFORMAT_SHORT4 }
+            }
+        },
+        .colors[0].blend = {
+            .enabled = true,
+            .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+            .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+            .src_factor_alpha = SG_BLENDFACTOR_ONE,
+            .dst_factor_alpha = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA
+        },
+        .label = "sprite-pipeline"
+    });
+
+    // pixel art, and frames sit right next to each other in the atlas
+    batch->sampler = sg_make_sampler(&(sg_sampler_desc) {
+        .min_filter = SG_FILTER_NEAREST,
+        .mag_filter = SG_FILTER_NEAREST,
+        .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+        .wrap_v = SG_WRAP_CLAMP_TO_EDGE
+    });
+
+    static const uint32_t white_pixel = 0xFFFFFFFF;
+    batch->white = sg_make_image(&(sg_image_desc) {
+        .width = 1,
+        .height = 1,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+        .data.subimage[0][0] = SG_RANGE(white_pixel),
+        .label = "sprite-white"
+    });
+    batch->palette = batch->white;
+
+    // 2:1 like the map's tiles. stretched over other shapes it stays a diamond touching the
+    // quad's edges, nearest sampling keeps the stair steps of a pixel art tile
+    enum { DIAMOND_W = 64, DIAMOND_H = 32 };
+    static uint32_t diamond_pixels[DIAMOND_W * DIAMOND_H];
+    for (int y = 0; y < DIAMOND_H; y++) {
+        for (int x = 0; x < DIAMOND_W; x++) {
+            float dx = fabsf(x + 0.5f - DIAMOND_W * 0.5f) / (DIAMOND_W * 0.5f);
+            float dy = fabsf(y + 0.5f - DIAMOND_H * 0.5f) / (DIAMOND_H * 0.5f);
+            diamond_pixels[y * DIAMOND_W + x] = dx + dy <= 1.0f ? 0xFFFFFFFF : 0;
+        }
+    }
+    batch->diamond = sg_make_image(&(sg_image_desc) {
+        .width = DIAMOND_W,
+        .height = DIAMOND_H,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+        .data.subimage[0][0] = SG_RANGE(diamond_pixels),
+        .label = "sprite-diamond"
+    });
+
+    return make_instance_buffer(batch, SPRITE_BATCH_INITIAL_CAPACITY) &&
+           sg_query_pipeline_state(batch->pipeline) == SG_RESOURCESTATE_VALID;
+}
+
+void sprite_batch_shutdown(SpriteBatch* batch) {
+    sg_destroy_buffer(batch->buffer);
+    sg_destroy_sampler(batch->sampler);
+    sg_destroy_image(batch->white);
+    sg_destroy_image(batch->diamond);
+    sg_destroy_pipeline(batch->pipeline);
+    sg_destroy_shader(batch->shader);
+    arrfree(batch->order);
+    arrfree(batch->tmp_keys);
+    arrfree(batch->tmp_order);
+    arrfree(batch->upload);
+}
+
+static void apply_pipeline(SpriteBatch* batch, const float view[4]) {
+    sprite_vs_params_t params = {
+        .view = { view[0], view[1], view[2], view[3] },
+        .time = { batch->time, 0.0f, 0.0f, 0.0f }
+    };
+    memcpy(params.clips, batch->clips, sizeof(batch->clips));
+    sg_apply_pipeline(batch->pipeline);
+    sg_apply_uniforms(UB_sprite_vs_params, &SG_RANGE(params));
+}
+
+static sg_image page_image(const SpriteBatch* batch, const SpriteAtlas* atlas, int page) {
+    if (page == SPRITE_PAGE_SOLID) return batch->white;
+    if (page == SPRITE_PAGE_DIAMOND) return batch->diamond;
+    if (page >= SPRITE_PAGE_TILESET) return batch->tilesets[page - SPRITE_PAGE_TILESET];
+    return atlas->pages[page].image;
+}
+
+static int page_of(const SpriteAtlas* atlas, sg_image texture) {
+    for (int i = 0; i < atlas->page_count; i++) {
+        if (atlas->pages[i].image.id == texture.id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static inline uint16_t unorm16(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 1.0f) return 65535;
+    return (uint16_t)(v * 65535.0f + 0.5f);
+}
+
+void sprite_batch_register_clips(SpriteBatch* batch, SpriteAtlas* atlas) {
+    for (int e = 0; e < atlas->entity_count; e++) {
+        LoadedSpriteData* entity = &atlas->entities[e];
+        for (int c = 0; c < entity->clip_count; c++) {
+            LoadedAnimationClip* clip = &entity->clips[c];
+            clip->shader_clip = 0;
+            if (clip->texture.id == SG_INVALID_ID) {
+                continue;  // its sheet never made it into the atlas
+            }
+            if (!clip->loop || clip->frame_count < 2 || clip->frame_time <= 0.0f) {
+                continue;
+            }
+            if (batch->clip_count >= SPRITE_MAX_SHADER_CLIPS) {
+                fprintf(stderr, "Shader clip table full, %s stays cpu animated\n", entity->name);
+                continue;
+            }
+
+            // frames sit side by side in the sheet, so stepping a frame is one frame width in u
+            const SpriteAtlasPage* page = &atlas->pages[clip->page];
+            float* slot = batch->clips[batch->clip_count++];
+            slot[0] = (float)clip->frame_count;
+            slot[1] = clip->frame_time;
+            slot[2] = (float)entity->width / page->width;
+            slot[3] = 0.0f;
+            clip->shader_clip = batch->clip_count;
+        }
+    }
+}
+
+void sprite_batch_register_palette(SpriteBatch* batch, const SpriteAtlas* atlas) {
+    batch->palette = atlas->palette.id != SG_INVALID_ID ? atlas->palette : batch->white;
+}
+
+void sprite_batch_advance(SpriteBatch* batch, float dt) {
+    batch->time = fmodf(batch->time + dt, SPRITE_ANIM_TIME_WRAP);
+}
+
+int sprite_batch_register_tileset(SpriteBatch* batch, sg_image image) {
+    for (int i = 0; i < batch->tileset_count; i++) {
+        if (batch->tilesets[i].id == image.id) {
+            return SPRITE_PAGE_TILESET + i;
+        }
+    }
+    if (batch->tileset_count >= SPRITE_MAX_TILESETS) {
+        return -1;
+    }
+    batch->tilesets[batch->tileset_count] = image;
+    return SPRITE_PAGE_TILESET + batch->tileset_count++;
+}
+
+bool sprite_instance_make(const SpriteAtlas* atlas, const Sprite* sprite, float x, float y,
+                          int layer, int anim_clip, SpriteInstance* out, uint64_t* key) {
+    int page = page_of(atlas, sprite->texture);
+    if (page < 0) {
+        return false;
+    }
+    float inv_w = 1.0f / atlas->pages[page].width;
+    float inv_h = 1.0f / atlas->pages[page].height;
+
+    *out = (SpriteInstance) {
+        .x = x,
+        .y = y,
+        .w = sprite->src_w * sprite->scale_x,
+        .h = sprite->src_h * sprite->scale_y,
+        .uv = {
+            unorm16(sprite->src_x * inv_w), unorm16(sprite->src_y * inv_h),
+            unorm16((sprite->src_x + sprite->src_w) * inv_w), unorm16((sprite->src_y + sprite->src_h) * inv_h)
+        },
+        .rotation = sprite->rotation,
+        .tint = { 255, 255, 255, 255 },
+        .anim_clip = (int16_t)anim_clip,
+        .palette = atlas->pages[page].indexed ? (int16_t)(sprite->palette + 1) : 0
+    };
+    *key = sprite_sort_key(layer, page, out->y + out->h, SPRITE_MATERIAL_DEFAULT);
+    return true;
+}
+
+void sprite_list_push(SpriteList* list, const SpriteAtlas* atlas, const Sprite* sprite,
+                      float x, float y, int layer, int anim_clip) {
+    SpriteInstance inst;
+    uint64_t key;
+    if (sprite_instance_make(atlas, sprite, x, y, layer, anim_clip, &inst, &key)) {
+        arrput(list->keys, key);
+        arrput(list->instances, inst);
+    }
+}
+
+void sprite_instance_flat(float x, float y, float w, float h, int layer, int page, const uint8_t tint[4],
+                          SpriteInstance* out, uint64_t* key) {
+    *out = (SpriteInstance) {
+        .x = x,
+        .y = y,
+        .w = w,
+        .h = h,
+        .uv = { 0, 0, 65535, 65535 },
+        .tint = { tint[0], tint[1], tint[2], tint[3] }
+    };
+    *key = sprite_sort_key(layer, page, y + h, SPRITE_MATERIAL_DEFAULT);
+}
+
+void sprite_list_push_rect(SpriteList* list, float x, float y, float w, float h, int layer,
+                           const uint8_t tint[4]) {
+    sprite_instance_flat(x, y, w, h, layer, SPRITE_PAGE_SOLID, tint, arraddnptr(list->instances, 1),
+                         arraddnptr(list->keys, 1));
+}
+
+void sprite_list_push_diamond(SpriteList* list, float x, float y, float w, float h, int layer,
+                              const uint8_t tint[4]) {
+    sprite_instance_flat(x, y, w, h, layer, SPRITE_PAGE_DIAMOND, tint, arraddnptr(list->instances, 1),
+                         arraddnptr(list->keys, 1));
+}
+
+void sprite_list_clear(SpriteList* list) {
+    arrsetlen(list->instances, 0);
+    arrsetlen(list->keys, 0);
+    list->presorted = false;
+}
+
+void sprite_list_free(SpriteList* list) {
+    arrfree(list->instances);
+    arrfree(list->keys);
+}
+
+void sprite_batch_draw(SpriteBatch* batch, const SpriteAtlas* atlas, SpriteList* list, const float view[4]) {
+    int count = (int)arrlen(list->instances);
+    if (count == 0) {
+        return;
+    }
+
+    if (count > batch->capacity) {
+        int capacity = batch->capacity * 2;
+        while (capacity < count) capacity *= 2;
+        if (!make_instance_buffer(batch, capacity)) {
+            fprintf(stderr, "failed to grow sprite instance buffer to %d\n", capacity);
+            sprite_list_clear(list);
+            return;
+        }
+    }
+
+    // a presorted list is uploaded as it is
+    const SpriteInstance* upload = list->instances;
+    if (!list->presorted) {
+        arrsetlen(batch->order, count);
+        for (int i = 0; i < count; i++) {
+            batch->order[i] = (uint32_t)i;
+        }
+        arrsetlen(batch->tmp_keys, count);
+        arrsetlen(batch->tmp_order, count);
+        radix_sort_u64(list->keys, batch->order, batch->tmp_keys, batch->tmp_order, count);
+
+        arrsetlen(batch->upload, count);
+        for (int i = 0; i < count; i++) {
+            batch->upload[i] = list->instances[batch->order[i]];
+        }
+        upload = batch->upload;
+    }
+
+    int offset = sg_append_buffer(batch->buffer, &(sg_range) { upload, (size_t)count * sizeof(SpriteInstance) });
+
+    apply_pipeline(batch, view);
+
+    // one draw per run of sprites on the same page, the key keeps those runs as long as
+    // the layers allow
+    int run_start = 0;
+    for (int i = 1; i <= count; i++) {
+        int page = (int)((list->keys[run_start] >> SPRITE_KEY_PAGE_SHIFT) & 0xFF);
+        if (i < count && (int)((list->keys[i] >> SPRITE_KEY_PAGE_SHIFT) & 0xFF) == page) {
+            continue;
+        }
+        sg_apply_bindings(&(sg_bindings) {
+            .vertex_buffers[0] = batch->buffer,
+            .vertex_buffer_offsets[0] = offset + run_start * (int)sizeof(SpriteInstance),
+            .images[IMG_sprite_tex] = page_image(batch, atlas, page),
+            .images[IMG_sprite_palette] = batch->palette,
+            .samplers[SMP_sprite_smp] = batch->sampler
+        });
+        sg_draw(0, 6, i - run_start);
+        render_stats_count(6 * (i - run_start), 1);
+        run_start = i;
+    }
+
+    sprite_list_clear(list);
+}
+
+void sprite_batch_begin_static(SpriteBatch* batch, const float view[4]) {
+    apply_pipeline(batch, view);
+}
+
+void sprite_batch_draw_static(SpriteBatch* batch, sg_buffer buffer, int first, int count, sg_image image) {
+    sg_apply_bindings(&(sg_bindings) {
+        .vertex_buffers[0] = buffer,
+        .vertex_buffer_offsets[0] = first * (int)sizeof(SpriteInstance),
+        .images[IMG_sprite_tex] = image,
+        .images[IMG_sprite_palette] = batch->palette,
+        .samplers[SMP_sprite_smp] = batch->sampler
+    });
+    sg_draw(0, 6, count);
+    render_stats_count(6 * count, 1);
+}
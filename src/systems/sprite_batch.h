@@ -0,0 +1,123 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <stdint.h>
+#include <string.h>
+#include "sokol_gfx.h"
+#include "util/sprite_loader.h"
+#include "components/sprite.h"
+
+#define SPRITE_BATCH_INITIAL_CAPACITY 4096
+#define SPRITE_MAX_SHADER_CLIPS 64     // size of the clip table in shader.glsl
+#define SPRITE_ANIM_TIME_WRAP 3600.0f  // keeps the time uniform precise
+
+// one record per sprite, 40 bytes. sokol_gp would upload six 20 byte vertices instead
+typedef struct {
+    float x, y;          // top-left in world space
+    float w, h;          // size after scaling
+    uint16_t uv[4];      // u0, v0, u1, v1 normalised to 0..65535
+    float rotation;
+    uint8_t tint[4];
+    int16_t anim_clip;   // shader clip + 1, 0 for sprites the cpu animates (or static ones)
+    int16_t anim_phase;  // frame offset into the loop
+    int16_t palette;     // atlas palette row + 1 on indexed pages, 0 samples colours directly
+    int16_t padding;
+} SpriteInstance;
+
+// draw order key, most significant first: layer | atlas page | depth | material.
+// depth is the bottom edge of the sprite so things further down the screen draw on top
+#define SPRITE_KEY_LAYER_SHIFT 56
+#define SPRITE_KEY_PAGE_SHIFT 48
+#define SPRITE_KEY_DEPTH_SHIFT 16
+#define SPRITE_MATERIAL_DEFAULT 0
+#define SPRITE_PAGE_TILESET 0xC0  // pages from here on are map tile sets registered with the batch
+#define SPRITE_PAGE_DIAMOND 0xFE  // flat coloured diamonds filling the quad, iso tiles at low zoom
+#define SPRITE_PAGE_SOLID 0xFF  // flat coloured quads, drawn with the batch's white texture
+#define SPRITE_MAX_TILESETS (SPRITE_PAGE_DIAMOND - SPRITE_PAGE_TILESET)
+
+// float bits that sort in the same order as the floats, negatives included
+static inline uint32_t sprite_depth_bits(float depth) {
+    uint32_t u;
+    memcpy(&u, &depth, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+static inline uint64_t sprite_sort_key(int layer, int page, float depth, uint16_t material) {
+    return ((uint64_t)(uint8_t)layer << SPRITE_KEY_LAYER_SHIFT) |
+           ((uint64_t)(uint8_t)page << SPRITE_KEY_PAGE_SHIFT) |
+           ((uint64_t)sprite_depth_bits(depth) << SPRITE_KEY_DEPTH_SHIFT) |
+           material;
+}
+
+// what one frame draws. filled by the extraction step and handed to the render thread in
+// the frame's packet, so it can't live in the batch itself
+typedef struct {
+    SpriteInstance* instances;  // stb_ds array
+    uint64_t* keys;             // sort key of each instance
+    bool presorted;             // already in draw order, the batch only splits it into runs
+} SpriteList;
+
+typedef struct {
+    uint32_t* order;            // instance indices, sorted by key
+    uint64_t* tmp_keys;         // radix sort scratch
+    uint32_t* tmp_order;
+    SpriteInstance* upload;     // instances in draw order
+    sg_buffer buffer;
+    int capacity;               // instances the buffer can hold
+    sg_shader shader;
+    sg_pipeline pipeline;
+    sg_sampler sampler;
+    sg_image white;             // 1x1, for SPRITE_PAGE_SOLID
+    sg_image diamond;           // white diamond on clear, for SPRITE_PAGE_DIAMOND
+    sg_image palette;           // the atlas palettes, white until there are any
+    sg_image tilesets[SPRITE_MAX_TILESETS];  // SPRITE_PAGE_TILESET onwards
+    int tileset_count;
+
+    // looping clips animated in the vertex shader: frame count, frame time, uv step
+    float clips[SPRITE_MAX_SHADER_CLIPS][4];
+    int clip_count;
+    float time;
+} SpriteBatch;
+
+bool sprite_batch_init(SpriteBatch* batch);
+void sprite_batch_shutdown(SpriteBatch* batch);
+
+// gives every looping clip in the atlas a slot in the shader's clip table (shader_clip),
+// has to run after the atlas is loaded and before anything is spawned from it
+void sprite_batch_register_clips(SpriteBatch* batch, SpriteAtlas* atlas);
+// binds the atlas palettes for indexed pages, after the atlas is loaded
+void sprite_batch_register_palette(SpriteBatch* batch, const SpriteAtlas* atlas);
+void sprite_batch_advance(SpriteBatch* batch, float dt);
+// lets instances sample a tile set image, for map tiles drawn in between sprites. returns
+// the page to put in their key, -1 once SPRITE_MAX_TILESETS are taken
+int sprite_batch_register_tileset(SpriteBatch* batch, sg_image image);
+
+// anim_clip is a shader clip from the table (0 for none), the sprite's src rect is then frame 0.
+// only reads the atlas, so any number of threads can build instances at once. false if the
+// sprite's texture isn't an atlas page
+bool sprite_instance_make(const SpriteAtlas* atlas, const Sprite* sprite, float x, float y,
+                          int layer, int anim_clip, SpriteInstance* out, uint64_t* key);
+void sprite_list_push(SpriteList* list, const SpriteAtlas* atlas, const Sprite* sprite,
+                      float x, float y, int layer, int anim_clip);
+// a flat quad in tint, used where detail is dropped at low zoom. page is SPRITE_PAGE_SOLID for
+// the whole rect or SPRITE_PAGE_DIAMOND for the diamond touching its edges
+void sprite_instance_flat(float x, float y, float w, float h, int layer, int page, const uint8_t tint[4],
+                          SpriteInstance* out, uint64_t* key);
+void sprite_list_push_rect(SpriteList* list, float x, float y, float w, float h, int layer,
+                           const uint8_t tint[4]);
+void sprite_list_push_diamond(SpriteList* list, float x, float y, float w, float h, int layer,
+                              const uint8_t tint[4]);
+void sprite_list_clear(SpriteList* list);
+void sprite_list_free(SpriteList* list);
+
+// sorts the list by key (unless it's presorted), uploads it in one append and draws each run of
+// sprites sharing an atlas page with one call, then clears it. view is the visible world rect (x0, y0, width, height). has to be called inside a
+// pass, after sgp_flush so it lands on top of what sokol_gp has drawn so far
+void sprite_batch_draw(SpriteBatch* batch, const SpriteAtlas* atlas, SpriteList* list, const float view[4]);
+
+// baked instance buffers (the tile map chunks) go through the same pipeline. begin applies
+// the pipeline and view once, each draw then binds its own buffer range and image
+void sprite_batch_begin_static(SpriteBatch* batch, const float view[4]);
+void sprite_batch_draw_static(SpriteBatch* batch, sg_buffer buffer, int first, int count, sg_image image);
+
+#endif
@@ -0,0 +1,227 @@
+#include "tilemap_render.h"
+#include <math.h>
+#include <float.h>
+#include "util/map_loader.h"
+#include "util/stb_ds.h"
+
+static void view_to_tile(const Map* map, float x, float y, float* tx, float* ty) {
+    const TileMap* t = &map->tiles;
+    if (t->isometric) {
+        float a = x / (t->tile_width * 0.5f) - (map->map_height - 1);
+        float b = y / (t->tile_height * 0.5f);
+        *tx = (a + b) * 0.5f;
+        *ty = (b - a) * 0.5f;
+    } else {
+        *tx = x / t->tile_width;
+        *ty = y / t->tile_height;
+    }
+}
+
+bool tilemap_tile_instance(const Map* map, int tile_x, int tile_y, uint32_t gid,
+                           SpriteInstance* out, int* tileset) {
+    const TileMap* t = &map->tiles;
+
+    // tilesets are ordered by firstgid, the last one starting at or below gid owns it
+    int ts = -1;
+    for (int i = 0; i < arrlen(t->tilesets); i++) {
+        if ((int)gid >= t->tilesets[i].firstgid) ts = i;
+    }
+    if (ts < 0 || t->tilesets[ts].image.id == SG_INVALID_ID) {
+        return false;
+    }
+    const MapTileset* set = &t->tilesets[ts];
+    int id = (int)gid - set->firstgid;
+    int src_x = set->margin + (id % set->columns) * (set->tile_w + set->spacing);
+    int src_y = set->margin + (id / set->columns) * (set->tile_h + set->spacing);
+
+    // tile images sit on the bottom of their footprint and can be taller than the grid
+    float x, y;
+    map_tile_to_world(map, tile_x, tile_y, &x, &y);
+    y += t->tile_height - set->tile_h;
+
+    *out = (SpriteInstance) {
+        .x = x,
+        .y = y,
+        .w = (float)set->tile_w,
+        .h = (float)set->tile_h,
+        .uv = {
+            (uint16_t)(65535.0f * src_x / set->image_w),
+            (uint16_t)(65535.0f * src_y / set->image_h),
+            (uint16_t)(65535.0f * (src_x + set->tile_w) / set->image_w),
+            (uint16_t)(65535.0f * (src_y + set->tile_h) / set->image_h)
+        },
+        .rotation = 0.0f,
+        .tint = { 255, 255, 255, 255 }
+    };
+    *tileset = ts;
+    return true;
+}
+
+int tilemap_baked_layers(const Map* map) {
+    int layers = (int)arrlen(map->tiles.layers);
+    return map->tiles.isometric && layers > 1 ? 1 : layers;
+}
+
+static void push_tile(const Map* map, int tx, int ty, uint32_t gid, SpriteInstance** instances, int** tilesets) {
+    SpriteInstance inst;
+    int ts;
+    if (tilemap_tile_instance(map, tx, ty, gid, &inst, &ts)) {
+        arrput(*instances, inst);
+        arrput(*tilesets, ts);
+    }
+}
+
+// builds a chunk's instances on the cpu. the buffer is made later by whoever draws the frame
+static void bake_chunk(Map* map, int cx, int cy, MapChunkBake* bake) {
+    TileMap* t = &map->tiles;
+
+    int tx0 = cx * TILEMAP_CHUNK_SIZE, ty0 = cy * TILEMAP_CHUNK_SIZE;
+    int tx1 = tx0 + TILEMAP_CHUNK_SIZE, ty1 = ty0 + TILEMAP_CHUNK_SIZE;
+    if (tx1 > map->map_width) tx1 = map->map_width;
+    if (ty1 > map->map_height) ty1 = map->map_height;
+
+    SpriteInstance* instances = NULL;
+    int* tilesets = NULL;
+
+    // layer by layer, each one back to front. in isometric that means along the diagonals
+    int layers = tilemap_baked_layers(map);
+    for (int l = 0; l < layers; l++) {
+        if (t->isometric) {
+            for (int d = tx0 + ty0; d <= tx1 + ty1 - 2; d++) {
+                for (int tx = tx0; tx < tx1; tx++) {
+                    int ty = d - tx;
+                    if (ty < ty0 || ty >= ty1) continue;
+                    uint32_t gid = t->layers[l].gids[ty * map->map_width + tx];
+                    if (gid) push_tile(map, tx, ty, gid, &instances, &tilesets);
+                }
+            }
+        } else {
+            for (int ty = ty0; ty < ty1; ty++) {
+                for (int tx = tx0; tx < tx1; tx++) {
+                    uint32_t gid = t->layers[l].gids[ty * map->map_width + tx];
+                    if (gid) push_tile(map, tx, ty, gid, &instances, &tilesets);
+                }
+            }
+        }
+    }
+
+    *bake = (MapChunkBake) {
+        .chunk = cy * t->chunks_x + cx,
+        .instances = instances,
+        .x0 = FLT_MAX, .y0 = FLT_MAX, .x1 = -FLT_MAX, .y1 = -FLT_MAX
+    };
+    int count = (int)arrlen(instances);
+    for (int i = 0; i < count; i++) {
+        if (instances[i].x < bake->x0) bake->x0 = instances[i].x;
+        if (instances[i].y < bake->y0) bake->y0 = instances[i].y;
+        if (instances[i].x + instances[i].w > bake->x1) bake->x1 = instances[i].x + instances[i].w;
+        if (instances[i].y + instances[i].h > bake->y1) bake->y1 = instances[i].y + instances[i].h;
+
+        if (i == 0 || tilesets[i] != tilesets[i - 1]) {
+            arrput(bake->runs, ((MapChunkRun) { tilesets[i], i, 0 }));
+        }
+        arrlast(bake->runs).count++;
+    }
+
+    arrfree(tilesets);
+}
+
+// replaces the chunk's buffer with the baked instances, the bake is emptied
+static void upload_chunk(TileMap* t, MapChunkBake* bake) {
+    MapChunk* chunk = &t->chunks[bake->chunk];
+
+    if (chunk->buffer.id != SG_INVALID_ID) {
+        sg_destroy_buffer(chunk->buffer);
+        chunk->buffer.id = SG_INVALID_ID;
+    }
+    arrfree(chunk->runs);
+    chunk->runs = bake->runs;
+    chunk->x0 = bake->x0;
+    chunk->y0 = bake->y0;
+    chunk->x1 = bake->x1;
+    chunk->y1 = bake->y1;
+
+    int count = (int)arrlen(bake->instances);
+    if (count > 0) {
+        chunk->buffer = sg_make_buffer(&(sg_buffer_desc) {
+            .size = (size_t)count * sizeof(SpriteInstance),
+            .usage = { .vertex_buffer = true, .immutable = true },
+            .data = { bake->instances, (size_t)count * sizeof(SpriteInstance) },
+            .label = "map-chunk"
+        });
+    }
+
+    arrfree(bake->instances);
+    bake->runs = NULL;
+}
+
+void tilemap_render_extract(AppState* state, RenderPacket* packet) {
+    Map* map = &state->map;
+    TileMap* t = &map->tiles;
+    if (!t->chunks) {
+        return;
+    }
+
+    const float* view = packet->view;
+    float vx0 = view[0], vy0 = view[1];
+    float vx1 = view[0] + view[2], vy1 = view[1] + view[3];
+
+    // tile range covered by the view corners, padded for tiles taller than the grid
+    float corners[4][2] = { { vx0, vy0 }, { vx1, vy0 }, { vx0, vy1 }, { vx1, vy1 } };
+    float min_tx = FLT_MAX, min_ty = FLT_MAX, max_tx = -FLT_MAX, max_ty = -FLT_MAX;
+    for (int i = 0; i < 4; i++) {
+        float tx, ty;
+        view_to_tile(map, corners[i][0], corners[i][1], &tx, &ty);
+        min_tx = fminf(min_tx, tx); max_tx = fmaxf(max_tx, tx);
+        min_ty = fminf(min_ty, ty); max_ty = fmaxf(max_ty, ty);
+    }
+    int cx0 = (int)floorf((min_tx - 2) / TILEMAP_CHUNK_SIZE), cx1 = (int)floorf((max_tx + 2) / TILEMAP_CHUNK_SIZE);
+    int cy0 = (int)floorf((min_ty - 2) / TILEMAP_CHUNK_SIZE), cy1 = (int)floorf((max_ty + 2) / TILEMAP_CHUNK_SIZE);
+    if (cx0 < 0) cx0 = 0;
+    if (cy0 < 0) cy0 = 0;
+    if (cx1 >= t->chunks_x) cx1 = t->chunks_x - 1;
+    if (cy1 >= t->chunks_y) cy1 = t->chunks_y - 1;
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            MapChunk* chunk = &t->chunks[cy * t->chunks_x + cx];
+            if (chunk->dirty) {
+                MapChunkBake bake;
+                bake_chunk(map, cx, cy, &bake);
+                arrput(packet->map_bakes, bake);
+                chunk->dirty = false;
+            }
+            arrput(packet->map_chunks, cy * t->chunks_x + cx);
+        }
+    }
+}
+
+void tilemap_render_draw(AppState* state, RenderPacket* packet) {
+    TileMap* t = &state->map.tiles;
+    if (!t->chunks) {
+        return;
+    }
+
+    for (int i = 0; i < arrlen(packet->map_bakes); i++) {
+        upload_chunk(t, &packet->map_bakes[i]);
+    }
+    arrsetlen(packet->map_bakes, 0);
+
+    const float* view = packet->view;
+    float vx0 = view[0], vy0 = view[1];
+    float vx1 = view[0] + view[2], vy1 = view[1] + view[3];
+
+    sprite_batch_begin_static(&state->renderer.sprites, view);
+    for (int i = 0; i < arrlen(packet->map_chunks); i++) {
+        MapChunk* chunk = &t->chunks[packet->map_chunks[i]];
+        if (chunk->buffer.id == SG_INVALID_ID ||
+            chunk->x1 < vx0 || chunk->x0 > vx1 || chunk->y1 < vy0 || chunk->y0 > vy1) {
+            continue;
+        }
+        for (int r = 0; r < arrlen(chunk->runs); r++) {
+            const MapChunkRun* run = &chunk->runs[r];
+            sprite_batch_draw_static(&state->renderer.sprites, chunk->buffer, run->first, run->count,
+                                     t->tilesets[run->tileset].image);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef TILEMAP_RENDER_H
+#define TILEMAP_RENDER_H
+
+#include "common.h"
+
+// static map layers. extraction (simulation thread) lists the chunks overlapping the
+// packet's view and rebakes the instances of any with a changed tile
+void tilemap_render_extract(AppState* state, RenderPacket* packet);
+
+// uploads the packet's rebaked chunks, then draws the listed ones straight from their
+// immutable buffers, one draw per tileset run. must be called inside the frame's pass,
+// before anything that should appear on top
+void tilemap_render_draw(AppState* state, RenderPacket* packet);
+
+// instance for one tile, and the tileset it samples. false if the tileset has no image
+bool tilemap_tile_instance(const Map* map, int tile_x, int tile_y, uint32_t gid,
+                           SpriteInstance* out, int* tileset);
+
+// how many layers are baked into chunks. isometric maps only bake the ground, the layers on
+// top stand up and are depth sorted with the entities (see iso_render.h)
+int tilemap_baked_layers(const Map* map);
+
+#endif
@@ -0,0 +1,359 @@
+#include "ui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "common.h"
+#include "systems/render_stats.h"
+#include "util/stb_ds.h"
+
+static const float ui_white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+// where along the window (and the widget) an anchor sits, 0, 0.5 or 1 each way
+static void anchor_fraction(text_anchor_t anchor, float* fx, float* fy) {
+    *fx = (float)((int)anchor % 3) * 0.5f;
+    *fy = (float)((int)anchor / 3) * 0.5f;
+}
+
+// grows rect (x, y, w, h) to cover other, an empty rect covers nothing
+static void rect_union(float rect[4], const float other[4]) {
+    if (other[2] <= 0.0f || other[3] <= 0.0f) {
+        return;
+    }
+    if (rect[2] <= 0.0f || rect[3] <= 0.0f) {
+        memcpy(rect, other, 4 * sizeof(float));
+        return;
+    }
+    float x0 = fminf(rect[0], other[0]);
+    float y0 = fminf(rect[1], other[1]);
+    float x1 = fmaxf(rect[0] + rect[2], other[0] + other[2]);
+    float y1 = fmaxf(rect[1] + rect[3], other[1] + other[3]);
+    rect[0] = x0;
+    rect[1] = y0;
+    rect[2] = x1 - x0;
+    rect[3] = y1 - y0;
+}
+
+static bool rect_overlaps(const sgp_rect* r, const float rect[4]) {
+    return r->x < rect[0] + rect[2] && r->x + r->w > rect[0] &&
+           r->y < rect[1] + rect[3] && r->y + r->h > rect[1];
+}
+
+static int add_widget(UiLayer* ui, UiWidget widget) {
+    widget.visible = true;
+    widget.dirty = true;
+    arrput(ui->widgets, widget);
+    return (int)arrlen(ui->widgets) - 1;
+}
+
+int ui_panel(UiLayer* ui, text_anchor_t anchor, float x, float y, float w, float h, const float colour[4]) {
+    UiWidget widget = { .type = UI_PANEL, .anchor = anchor, .x = x, .y = y, .w = w, .h = h };
+    memcpy(widget.colour, colour, sizeof(widget.colour));
+    return add_widget(ui, widget);
+}
+
+int ui_label(UiLayer* ui, text_anchor_t anchor, float x, float y, int font, const float colour[4], const char* text) {
+    UiWidget widget = { .type = UI_LABEL, .anchor = anchor, .x = x, .y = y, .font = font };
+    memcpy(widget.colour, colour, sizeof(widget.colour));
+    strncpy(widget.text, text, UI_TEXT_MAX - 1);
+    return add_widget(ui, widget);
+}
+
+int ui_grid(UiLayer* ui, text_anchor_t anchor, float x, float y, int columns, int rows, float cell,
+            const float colour[4]) {
+    UiWidget widget = {
+        .type = UI_GRID, .anchor = anchor, .x = x, .y = y,
+        .columns = columns, .rows = rows, .cell = cell,
+        .w = columns * cell + (columns + 1) * UI_GRID_GAP,
+        .h = rows * cell + (rows + 1) * UI_GRID_GAP,
+        .slots = calloc((size_t)columns * rows, sizeof(UiSlot))
+    };
+    memcpy(widget.colour, colour, sizeof(widget.colour));
+    return add_widget(ui, widget);
+}
+
+void ui_set_text(UiLayer* ui, int id, const char* text) {
+    UiWidget* widget = &ui->widgets[id];
+    if (strncmp(widget->text, text, UI_TEXT_MAX - 1) == 0) {
+        return;
+    }
+    strncpy(widget->text, text, UI_TEXT_MAX - 1);
+    widget->dirty = true;
+}
+
+void ui_set_slot(UiLayer* ui, int id, int slot, const float colour[4], int count) {
+    UiWidget* widget = &ui->widgets[id];
+    if (slot < 0 || slot >= widget->columns * widget->rows) {
+        return;
+    }
+    UiSlot* s = &widget->slots[slot];
+    if (s->count == count && memcmp(s->colour, colour, sizeof(s->colour)) == 0) {
+        return;
+    }
+    memcpy(s->colour, colour, sizeof(s->colour));
+    s->count = count;
+    widget->dirty = true;
+}
+
+void ui_set_visible(UiLayer* ui, int id, bool visible) {
+    UiWidget* widget = &ui->widgets[id];
+    if (widget->visible != visible) {
+        widget->visible = visible;
+        widget->dirty = true;
+    }
+}
+
+void ui_shutdown(UiLayer* ui) {
+    for (int i = 0; i < arrlen(ui->widgets); i++) {
+        free(ui->widgets[i].slots);
+        arrfree(ui->widgets[i].quads);
+    }
+    arrfree(ui->widgets);
+    arrfree(ui->quads);
+}
+
+static void add_solid(UiWidget* widget, float x, float y, float w, float h, const float colour[4]) {
+    UiQuad quad = { .dst = { x, y, w, h }, .font = -1 };
+    memcpy(quad.colour, colour, sizeof(quad.colour));
+    arrput(widget->quads, quad);
+}
+
+static void add_text(UiWidget* widget, text_renderer_t* text, int font, const char* str, float x, float y,
+                     text_anchor_t anchor, const float colour[4]) {
+    text_glyph_t glyphs[UI_TEXT_MAX];
+    int count = text_renderer_layout_text(text, font, str, x, y, 1.0f, anchor, glyphs, UI_TEXT_MAX);
+    for (int i = 0; i < count; i++) {
+        UiQuad quad = { .dst = glyphs[i].dst, .src = glyphs[i].src, .font = font };
+        memcpy(quad.colour, colour, sizeof(quad.colour));
+        arrput(widget->quads, quad);
+    }
+}
+
+// the only place glyphs are placed, everything after works from the cached quads
+static void layout_widget(UiLayer* ui, text_renderer_t* text, UiWidget* widget) {
+    arrsetlen(widget->quads, 0);
+    memset(widget->bounds, 0, sizeof(widget->bounds));
+    if (!widget->visible) {
+        return;
+    }
+
+    float fx, fy;
+    anchor_fraction(widget->anchor, &fx, &fy);
+    float px = ui->width * fx + widget->x;
+    float py = ui->height * fy + widget->y;
+    float x0 = px - widget->w * fx;
+    float y0 = py - widget->h * fy;
+
+    switch (widget->type) {
+        case UI_PANEL:
+            add_solid(widget, x0, y0, widget->w, widget->h, widget->colour);
+            break;
+        case UI_LABEL:
+            add_text(widget, text, widget->font, widget->text, px, py, widget->anchor, widget->colour);
+            break;
+        case UI_GRID: {
+            float step = widget->cell + UI_GRID_GAP;
+            for (int r = 0; r < widget->rows; r++) {
+                for (int c = 0; c < widget->columns; c++) {
+                    const UiSlot* slot = &widget->slots[r * widget->columns + c];
+                    float cx = x0 + UI_GRID_GAP + c * step;
+                    float cy = y0 + UI_GRID_GAP + r * step;
+                    add_solid(widget, cx, cy, widget->cell, widget->cell, widget->colour);
+                    if (slot->colour[3] <= 0.0f) {
+                        continue;
+                    }
+                    float inset = widget->cell * 0.2f;
+                    add_solid(widget, cx + inset, cy + inset, widget->cell - 2 * inset, widget->cell - 2 * inset,
+                              slot->colour);
+                    if (slot->count > 1) {
+                        char count[16];
+                        snprintf(count, sizeof(count), "%d", slot->count);
+                        add_text(widget, text, widget->font, count, cx + widget->cell - 2.0f,
+                                 cy + widget->cell - 2.0f, TEXT_ANCHOR_BOTTOM_RIGHT, ui_white);
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    // a pixel of slack for filtering at the edges
+    for (int i = 0; i < arrlen(widget->quads); i++) {
+        const sgp_rect* r = &widget->quads[i].dst;
+        rect_union(widget->bounds, (float[4]) { r->x - 1.0f, r->y - 1.0f, r->w + 2.0f, r->h + 2.0f });
+    }
+}
+
+void ui_extract(AppState* state, RenderPacket* packet) {
+    UiLayer* ui = &state->ui;
+    text_renderer_t* text = state->renderer.text_renderer;
+
+    // everything hangs off the window's edges, a resize moves it all
+    bool full = false;
+    if (ui->width != state->width || ui->height != state->height) {
+        ui->width = state->width;
+        ui->height = state->height;
+        for (int i = 0; i < arrlen(ui->widgets); i++) {
+            ui->widgets[i].dirty = true;
+        }
+        full = true;
+    }
+
+    // what a changed widget covered before and after
+    float dirty[4] = {0};
+    bool changed = false;
+    for (int i = 0; i < arrlen(ui->widgets); i++) {
+        UiWidget* widget = &ui->widgets[i];
+        if (!widget->dirty) {
+            continue;
+        }
+        rect_union(dirty, widget->bounds);
+        layout_widget(ui, text, widget);
+        rect_union(dirty, widget->bounds);
+        widget->dirty = false;
+        changed = true;
+    }
+
+    packet->ui_version = ui->version;
+    if (!changed) {
+        return;
+    }
+
+    arrsetlen(ui->quads, 0);
+    for (int i = 0; i < arrlen(ui->widgets); i++) {
+        const UiWidget* widget = &ui->widgets[i];
+        int count = (int)arrlen(widget->quads);
+        if (count > 0) {
+            memcpy(arraddnptr(ui->quads, count), widget->quads, (size_t)count * sizeof(UiQuad));
+        }
+    }
+    ui->version++;
+
+    packet->ui_version = ui->version;
+    packet->ui_full = full;
+    memcpy(packet->ui_dirty, dirty, sizeof(dirty));
+    int count = (int)arrlen(ui->quads);
+    arrsetlen(packet->ui_quads, count);
+    if (count > 0) {
+        memcpy(packet->ui_quads, ui->quads, (size_t)count * sizeof(UiQuad));
+    }
+}
+
+// draws the quads that touch region, in order. runs of glyphs in one font and colour go out
+// together
+static void draw_quads(text_renderer_t* text, const UiQuad* quads, int count, const float region[4]) {
+    text_glyph_t glyphs[TEXT_MAX_GLYPHS];
+    int run = 0;
+    int run_font = -1;
+    const float* run_colour = NULL;
+
+    for (int i = 0; i <= count; i++) {
+        const UiQuad* quad = i < count ? &quads[i] : NULL;
+        if (quad && !rect_overlaps(&quad->dst, region)) {
+            continue;
+        }
+        bool same = quad && quad->font >= 0 && quad->font == run_font &&
+                    memcmp(quad->colour, run_colour, 4 * sizeof(float)) == 0 && run < TEXT_MAX_GLYPHS;
+        if (run > 0 && !same) {
+            text_renderer_draw_glyphs(text, run_font, glyphs, run, run_colour);
+            run = 0;
+        }
+        if (!quad) {
+            break;
+        }
+
+        if (quad->font < 0) {
+            if (renderer_sgp_room(1, 6, 0) == 0) {
+                continue;
+            }
+            sgp_set_blend_mode(SGP_BLENDMODE_BLEND);
+            sgp_set_color(quad->colour[0], quad->colour[1], quad->colour[2], quad->colour[3]);
+            sgp_draw_filled_rect(quad->dst.x, quad->dst.y, quad->dst.w, quad->dst.h);
+            sgp_reset_color();
+            sgp_reset_blend_mode();
+            continue;
+        }
+        run_font = quad->font;
+        run_colour = quad->colour;
+        glyphs[run++] = (text_glyph_t) { quad->dst, quad->src };
+    }
+}
+
+void ui_render(AppState* state, RenderPacket* packet) {
+    UiCache* cache = &state->renderer.ui;
+    int pixel_width = packet->pixel_width;
+    int pixel_height = packet->pixel_height;
+
+    bool changed = packet->ui_version != cache->version;
+    if (changed) {
+        int count = (int)arrlen(packet->ui_quads);
+        arrsetlen(cache->quads, count);
+        if (count > 0) {
+            memcpy(cache->quads, packet->ui_quads, (size_t)count * sizeof(UiQuad));
+        }
+        cache->version = packet->ui_version;
+    }
+    bool remade = cache->target.pass.id == SG_INVALID_ID ||
+                  cache->target.width != pixel_width || cache->target.height != pixel_height;
+    if (!changed && !remade) {
+        return;
+    }
+    if (!scene_target_resize(&cache->target, pixel_width, pixel_height)) {
+        return;
+    }
+
+    // a fresh target has nothing worth keeping, otherwise only the changed rect is cleared
+    bool full = remade || packet->ui_full;
+    float region[4] = { 0.0f, 0.0f, (float)packet->width, (float)packet->height };
+    if (!full) {
+        memcpy(region, packet->ui_dirty, sizeof(region));
+    }
+
+    sg_begin_pass(&(sg_pass) {
+        .action.colors[0] = {
+            .load_action = full ? SG_LOADACTION_CLEAR : SG_LOADACTION_LOAD,
+            .clear_value = { 0.0f, 0.0f, 0.0f, 0.0f }
+        },
+        .attachments = cache->target.pass
+    });
+    sgp_begin(pixel_width, pixel_height);
+    sgp_project(0.0f, (float)packet->width, 0.0f, (float)packet->height);
+
+    if (!full) {
+        float sx = (float)pixel_width / packet->width;
+        float sy = (float)pixel_height / packet->height;
+        int x0 = (int)floorf(region[0] * sx), y0 = (int)floorf(region[1] * sy);
+        int x1 = (int)ceilf((region[0] + region[2]) * sx), y1 = (int)ceilf((region[1] + region[3]) * sy);
+        sgp_scissor(x0, y0, x1 - x0, y1 - y0);
+        sgp_set_blend_mode(SGP_BLENDMODE_NONE);
+        sgp_set_color(0.0f, 0.0f, 0.0f, 0.0f);
+        if (renderer_sgp_room(1, 6, 0) > 0) {
+            sgp_draw_filled_rect(region[0], region[1], region[2], region[3]);
+        }
+        sgp_reset_color();
+        sgp_reset_blend_mode();
+    }
+    draw_quads(state->renderer.text_renderer, cache->quads, (int)arrlen(cache->quads), region);
+
+    sgp_flush();
+    sgp_end();
+    renderer_sgp_check(state);
+    sg_end_pass();
+}
+
+void ui_draw(AppState* state, RenderPacket* packet) {
+    UiCache* cache = &state->renderer.ui;
+    if (cache->target.pass.id == SG_INVALID_ID || arrlen(cache->quads) == 0) {
+        return;
+    }
+    // drawing into the target already multiplied colour by alpha
+    sgp_set_blend_mode(SGP_BLENDMODE_BLEND_PREMULTIPLIED);
+    scene_target_draw(&cache->target, (float)packet->width, (float)packet->height);
+    sgp_reset_blend_mode();
+}
+
+void ui_cache_destroy(UiCache* cache) {
+    scene_target_destroy(&cache->target);
+    arrfree(cache->quads);
+    cache->version = 0;
+}
@@ -0,0 +1,98 @@
+#ifndef UI_H
+#define UI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "font_rendering.h"
+#include "systems/render_scale.h"
+
+// retained ui: panels, labels and inventory grids that keep their laid out quads between
+// frames. a widget is only laid out again when its content changes (setting the same text is
+// free), and the renderer keeps the whole ui in a texture it composites with one quad. when
+// something changes only the screen rect it covered before and after is redrawn into that
+// texture, so big inventory or statistics screens cost nothing while they sit still
+
+#define UI_TEXT_MAX 128
+#define UI_GRID_GAP 4.0f
+
+typedef enum {
+    UI_PANEL,
+    UI_LABEL,
+    UI_GRID
+} UiWidgetType;
+
+// what a grid slot shows, a swatch of the item's colour and how many there are
+typedef struct {
+    float colour[4];   // alpha 0 for an empty slot
+    int count;
+} UiSlot;
+
+// one quad of laid out ui. solid quads have font -1
+typedef struct {
+    sgp_rect dst;
+    sgp_rect src;
+    int font;
+    float colour[4];
+} UiQuad;
+
+typedef struct {
+    UiWidgetType type;
+    bool visible;
+    text_anchor_t anchor;  // point of the window x, y are measured from, and of the widget that sits there
+    float x, y;
+    float w, h;            // panels, grids work theirs out from the cells
+    float colour[4];       // panel fill, label text, grid cell background
+
+    char text[UI_TEXT_MAX];
+    int font;
+
+    int columns, rows;
+    float cell;
+    UiSlot* slots;         // columns * rows, malloc'd
+
+    UiQuad* quads;         // stb_ds array, rebuilt when dirty
+    float bounds[4];       // x, y, w, h the quads covered when last built
+    bool dirty;
+} UiWidget;
+
+// simulation side, in window coordinates
+typedef struct {
+    UiWidget* widgets;     // stb_ds array, drawn in order
+    UiQuad* quads;         // every visible widget's quads, what the renderer gets
+    uint32_t version;      // bumped whenever quads change
+    int width, height;     // window size it was laid out for
+} UiLayer;
+
+// render side, what the ui looked like when last drawn
+typedef struct {
+    SceneTarget target;    // pixel sized, premultiplied alpha
+    UiQuad* quads;         // stb_ds array, kept to redraw after a resize
+    uint32_t version;
+} UiCache;
+
+struct AppState;
+struct RenderPacket;
+
+void ui_shutdown(UiLayer* ui);
+
+// return the widget's id
+int ui_panel(UiLayer* ui, text_anchor_t anchor, float x, float y, float w, float h, const float colour[4]);
+int ui_label(UiLayer* ui, text_anchor_t anchor, float x, float y, int font, const float colour[4], const char* text);
+int ui_grid(UiLayer* ui, text_anchor_t anchor, float x, float y, int columns, int rows, float cell,
+            const float colour[4]);
+
+// only mark the widget dirty if something actually changed
+void ui_set_text(UiLayer* ui, int id, const char* text);
+void ui_set_slot(UiLayer* ui, int id, int slot, const float colour[4], int count);
+void ui_set_visible(UiLayer* ui, int id, bool visible);
+
+// simulation side: lays out dirty widgets and hands the quads and the rect to redraw to the
+// packet, only if anything changed
+void ui_extract(struct AppState* state, struct RenderPacket* packet);
+// render side: redraws the changed part of the cached texture, outside any pass
+void ui_render(struct AppState* state, struct RenderPacket* packet);
+// composites the texture over whatever is drawn, in window coordinates
+void ui_draw(struct AppState* state, struct RenderPacket* packet);
+void ui_cache_destroy(UiCache* cache);
+
+#endif
@@ -0,0 +1,53 @@
+#include "camera.h"
+
+void camera_init(Camera* camera, int viewport_w, int viewport_h) {
+    // start out looking at the same area the fixed projection used to show
+    camera->x = viewport_w * 0.5f;
+    camera->y = viewport_h * 0.5f;
+    camera->zoom = 1.0f;
+    camera->viewport_w = viewport_w;
+    camera->viewport_h = viewport_h;
+}
+
+void camera_set_viewport(Camera* camera, int viewport_w, int viewport_h) {
+    camera->viewport_w = viewport_w;
+    camera->viewport_h = viewport_h;
+}
+
+RenderLod camera_lod(const Camera* camera) {
+    if (camera->zoom < CAMERA_LOD_CHUNKS_ZOOM) return RENDER_LOD_CHUNKS;
+    if (camera->zoom < CAMERA_LOD_LANES_ZOOM) return RENDER_LOD_LANES;
+    return RENDER_LOD_FULL;
+}
+
+void camera_view_bounds(const Camera* camera, float* x0, float* y0, float* x1, float* y1) {
+    float half_w = camera->viewport_w * 0.5f / camera->zoom;
+    float half_h = camera->viewport_h * 0.5f / camera->zoom;
+    *x0 = camera->x - half_w;
+    *y0 = camera->y - half_h;
+    *x1 = camera->x + half_w;
+    *y1 = camera->y + half_h;
+}
+
+void camera_screen_to_world(const Camera* camera, float sx, float sy, float* wx, float* wy) {
+    *wx = camera->x + (sx - camera->viewport_w * 0.5f) / camera->zoom;
+    *wy = camera->y + (sy - camera->viewport_h * 0.5f) / camera->zoom;
+}
+
+void camera_pan(Camera* camera, float dx, float dy) {
+    camera->x += dx / camera->zoom;
+    camera->y += dy / camera->zoom;
+}
+
+void camera_zoom_at(Camera* camera, float sx, float sy, float factor) {
+    float before_x, before_y, after_x, after_y;
+    camera_screen_to_world(camera, sx, sy, &before_x, &before_y);
+
+    camera->zoom *= factor;
+    if (camera->zoom < CAMERA_MIN_ZOOM) camera->zoom = CAMERA_MIN_ZOOM;
+    if (camera->zoom > CAMERA_MAX_ZOOM) camera->zoom = CAMERA_MAX_ZOOM;
+
+    camera_screen_to_world(camera, sx, sy, &after_x, &after_y);
+    camera->x += before_x - after_x;
+    camera->y += before_y - after_y;
+}
@@ -0,0 +1,32 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "common.h"
+
+#define CAMERA_MIN_ZOOM 0.05f
+#define CAMERA_MAX_ZOOM 4.0f
+
+// zoom levels below which the world is drawn with less detail
+#define CAMERA_LOD_LANES_ZOOM 0.5f    // belts become flat tiles with lane fill strips, items aren't drawn
+#define CAMERA_LOD_CHUNKS_ZOOM 0.15f  // each grid chunk becomes one tile coloured by what is in it
+
+typedef enum {
+    RENDER_LOD_FULL,
+    RENDER_LOD_LANES,
+    RENDER_LOD_CHUNKS
+} RenderLod;
+
+void camera_init(Camera* camera, int viewport_w, int viewport_h);
+void camera_set_viewport(Camera* camera, int viewport_w, int viewport_h);
+
+RenderLod camera_lod(const Camera* camera);
+
+// visible world rectangle
+void camera_view_bounds(const Camera* camera, float* x0, float* y0, float* x1, float* y1);
+void camera_screen_to_world(const Camera* camera, float sx, float sy, float* wx, float* wy);
+
+// pan by a screen space delta, zoom keeping the world point under (sx, sy) fixed
+void camera_pan(Camera* camera, float dx, float dy);
+void camera_zoom_at(Camera* camera, float sx, float sy, float factor);
+
+#endif
@@ -0,0 +1,161 @@
+#include "depth_order.h"
+#include <stdlib.h>
+#include "util/stb_ds.h"
+
+static inline bool entry_before(const DepthEntry* a, const DepthEntry* b) {
+    return a->layer < b->layer || (a->layer == b->layer && a->depth < b->depth);
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const DepthEntry* ea = (const DepthEntry*) a;
+    const DepthEntry* eb = (const DepthEntry*) b;
+    if (entry_before(ea, eb)) return -1;
+    if (entry_before(eb, ea)) return 1;
+    return 0;
+}
+
+// removed entries keep their place until the flush but aren't indexed any more
+static inline void set_slot(DepthOrder* order, int i) {
+    if (order->entries[i].id) {
+        hmput(order->slots, order->entries[i].id, i);
+    }
+}
+
+void depth_order_free(DepthOrder* order) {
+    arrfree(order->entries);
+    hmfree(order->slots);
+    arrfree(order->pending);
+    arrfree(order->merged);
+    order->removed = 0;
+}
+
+void depth_order_insert(DepthOrder* order, uint64_t id, int layer, float depth) {
+    if (hmgetp_null(order->slots, id)) {
+        depth_order_move(order, id, depth);
+        return;
+    }
+    arrput(order->pending, ((DepthEntry) { id, depth, (uint8_t)layer }));
+}
+
+void depth_order_remove(DepthOrder* order, uint64_t id) {
+    DepthSlot* slot = hmgetp_null(order->slots, id);
+    if (slot) {
+        order->entries[slot->value].id = 0;
+        hmdel(order->slots, id);
+        order->removed++;
+        return;
+    }
+    for (int i = 0; i < arrlen(order->pending); i++) {
+        if (order->pending[i].id == id) {
+            arrdelswap(order->pending, i);
+            return;
+        }
+    }
+}
+
+const DepthEntry* depth_order_get(DepthOrder* order, uint64_t id) {
+    DepthSlot* slot = hmgetp_null(order->slots, id);
+    return slot ? &order->entries[slot->value] : NULL;
+}
+
+void depth_order_move(DepthOrder* order, uint64_t id, float depth) {
+    DepthSlot* slot = hmgetp_null(order->slots, id);
+    if (!slot) {
+        // not merged in yet, the flush puts it in the right place
+        for (int i = 0; i < arrlen(order->pending); i++) {
+            if (order->pending[i].id == id) {
+                order->pending[i].depth = depth;
+                break;
+            }
+        }
+        return;
+    }
+
+    int i = slot->value;
+    DepthEntry moved = order->entries[i];
+    if (moved.depth == depth) {
+        return;
+    }
+    moved.depth = depth;
+
+    // shift the neighbours it passes over by one, at most one of these loops runs
+    int count = (int)arrlen(order->entries);
+    while (i > 0 && entry_before(&moved, &order->entries[i - 1])) {
+        order->entries[i] = order->entries[i - 1];
+        set_slot(order, i);
+        i--;
+    }
+    while (i < count - 1 && entry_before(&order->entries[i + 1], &moved)) {
+        order->entries[i] = order->entries[i + 1];
+        set_slot(order, i);
+        i++;
+    }
+    order->entries[i] = moved;
+    set_slot(order, i);
+}
+
+void depth_order_flush(DepthOrder* order) {
+    int pending = (int)arrlen(order->pending);
+    if (pending == 0 && order->removed == 0) {
+        return;
+    }
+
+    // a frame's additions are few, sort them and merge them in with one pass
+    qsort(order->pending, pending, sizeof(DepthEntry), compare_entries);
+
+    int count = (int)arrlen(order->entries);
+    arrsetlen(order->merged, count + pending);
+    int merged = 0, p = 0;
+    for (int i = 0; i < count; i++) {
+        while (p < pending && entry_before(&order->pending[p], &order->entries[i])) {
+            order->merged[merged++] = order->pending[p++];
+        }
+        if (order->entries[i].id) {
+            order->merged[merged++] = order->entries[i];
+        }
+    }
+    while (p < pending) {
+        order->merged[merged++] = order->pending[p++];
+    }
+    arrsetlen(order->merged, merged);
+
+    // everything before the first difference kept its index
+    int first = 0;
+    while (first < merged && first < count && order->merged[first].id == order->entries[first].id) {
+        first++;
+    }
+
+    DepthEntry* old = order->entries;
+    order->entries = order->merged;
+    order->merged = old;
+    for (int i = first; i < merged; i++) {
+        hmput(order->slots, order->entries[i].id, i);
+    }
+
+    arrsetlen(order->pending, 0);
+    order->removed = 0;
+}
+
+void depth_order_range(const DepthOrder* order, int layer, float lo, float hi, int* first, int* last) {
+    DepthEntry low = { 0, lo, (uint8_t)layer };
+    DepthEntry high = { 0, hi, (uint8_t)layer };
+    int count = (int)arrlen(order->entries);
+
+    // first entry not before (layer, lo)
+    int a = 0, b = count;
+    while (a < b) {
+        int mid = (a + b) / 2;
+        if (entry_before(&order->entries[mid], &low)) a = mid + 1;
+        else b = mid;
+    }
+    *first = a;
+
+    // first entry after (layer, hi)
+    b = count;
+    while (a < b) {
+        int mid = (a + b) / 2;
+        if (entry_before(&high, &order->entries[mid])) b = mid;
+        else a = mid + 1;
+    }
+    *last = a;
+}
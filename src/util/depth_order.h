@@ -0,0 +1,47 @@
+#ifndef DEPTH_ORDER_H
+#define DEPTH_ORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// things kept in draw order from one frame to the next instead of being sorted every frame.
+// an entry that moves is walked to its new place one neighbour at a time (insertion sort of
+// just that entry), so a frame costs about how many things moved and how far, not how many
+// there are. adds and removes are batched and merged in once per frame by depth_order_flush
+
+typedef struct {
+    uint64_t id;     // 0 once removed, dropped at the next flush
+    float depth;
+    uint8_t layer;   // sorts before depth
+} DepthEntry;
+
+typedef struct {
+    uint64_t key;
+    int value;
+} DepthSlot;
+
+typedef struct {
+    DepthEntry* entries;   // stb_ds array, sorted by layer then depth
+    DepthSlot* slots;      // stb_ds hashmap, id -> index into entries
+    DepthEntry* pending;   // added since the last flush, stb_ds array
+    DepthEntry* merged;    // flush scratch
+    int removed;           // entries waiting to be dropped
+} DepthOrder;
+
+void depth_order_free(DepthOrder* order);
+
+void depth_order_insert(DepthOrder* order, uint64_t id, int layer, float depth);
+void depth_order_remove(DepthOrder* order, uint64_t id);
+// NULL if id isn't in the order (or is still pending)
+const DepthEntry* depth_order_get(DepthOrder* order, uint64_t id);
+// new depth for an entry that moved, nothing happens if it didn't change
+void depth_order_move(DepthOrder* order, uint64_t id, float depth);
+
+// merges pending entries in and drops removed ones. only the entries from the first change
+// onwards are re-indexed
+void depth_order_flush(DepthOrder* order);
+
+// index range [first, last) of the entries in layer with lo <= depth <= hi
+void depth_order_range(const DepthOrder* order, int layer, float lo, float hi, int* first, int* last);
+
+#endif
@@ -7,6 +7,14 @@ int world_to_tile(float pos) {
     return f_pos;
 }
 
+int world_to_chunk(float pos) {
+    return (int)floorf(pos / (TILE_SIZE * GRID_CHUNK_SIZE));
+}
+
+static inline uint64_t chunk_key(int chunk_x, int chunk_y) {
+    return ((uint64_t) (uint32_t)chunk_x << 32) | (uint32_t)chunk_y;
+}
+
 static inline uint64_t grid_key(Position pos) {
     int x = world_to_tile(pos.x);
     int y = world_to_tile(pos.y);
@@ -20,10 +28,15 @@ ecs_entity_t get_entity_at_grid_position(AppState* state, int x, int y) {
 
 void insert_entity_to_grid(AppState* state, int x, int y, ecs_entity_t entity) {
     hmput(state->grid, grid_key((Position) {x, y}), entity);
+    // buildings block walking, only the chunk the tile sits in gets rebuilt
+    pathfinding_set_blocked(&state->pathfinding, world_to_tile(x), world_to_tile(y), true);
+    minimap_mark_dirty(&state->minimap, world_to_tile(x), world_to_tile(y));
 }
 
 void delete_entity_from_grid(AppState* state, int x, int y, ecs_entity_t entity) {
     hmdel(state->grid, grid_key((Position) {x, y}));
+    pathfinding_set_blocked(&state->pathfinding, world_to_tile(x), world_to_tile(y), false);
+    minimap_mark_dirty(&state->minimap, world_to_tile(x), world_to_tile(y));
 }
 
 bool does_exist_in_grid(AppState* state, int x, int y) {
@@ -31,3 +44,54 @@ bool does_exist_in_grid(AppState* state, int x, int y) {
     return entry ? true : false;
 }
 
+// the far zoom tile of the chunk has to be recounted
+static void mark_chunk_lod_dirty(AppState* state, uint64_t key) {
+    GridChunkLod* lod = hmgetp_null(state->chunk_lods, key);
+    if (!lod) {
+        hmput(state->chunk_lods, key, ((ChunkLod) { .dirty = true }));
+    } else {
+        lod->value.dirty = true;
+    }
+}
+
+void grid_chunk_add(AppState* state, int chunk_x, int chunk_y, ecs_entity_t entity) {
+    GridChunk* chunk = hmgetp_null(state->grid_chunks, chunk_key(chunk_x, chunk_y));
+    if (!chunk) {
+        hmput(state->grid_chunks, chunk_key(chunk_x, chunk_y), NULL);
+        chunk = hmgetp_null(state->grid_chunks, chunk_key(chunk_x, chunk_y));
+    }
+    arrput(chunk->value, entity);
+    mark_chunk_lod_dirty(state, chunk_key(chunk_x, chunk_y));
+}
+
+void grid_chunk_remove(AppState* state, int chunk_x, int chunk_y, ecs_entity_t entity) {
+    GridChunk* chunk = hmgetp_null(state->grid_chunks, chunk_key(chunk_x, chunk_y));
+    if (!chunk) {
+        return;
+    }
+    for (int i = 0; i < arrlen(chunk->value); i++) {
+        if (chunk->value[i] == entity) {
+            arrdelswap(chunk->value, i);
+            mark_chunk_lod_dirty(state, chunk_key(chunk_x, chunk_y));
+            return;
+        }
+    }
+}
+
+void grid_chunk_track(AppState* state, ecs_entity_t entity, float x, float y) {
+    int cx = world_to_chunk(x);
+    int cy = world_to_chunk(y);
+    ecs_set(state->ecs, entity, GridChunkRef, { cx, cy });
+    grid_chunk_add(state, cx, cy, entity);
+    iso_render_track(state, entity);
+}
+
+ecs_entity_t* grid_chunk_entities(AppState* state, int chunk_x, int chunk_y) {
+    GridChunk* chunk = hmgetp_null(state->grid_chunks, chunk_key(chunk_x, chunk_y));
+    return chunk ? chunk->value : NULL;
+}
+
+ChunkLod* grid_chunk_lod(AppState* state, int chunk_x, int chunk_y) {
+    GridChunkLod* lod = hmgetp_null(state->chunk_lods, chunk_key(chunk_x, chunk_y));
+    return lod ? &lod->value : NULL;
+}
@@ -4,12 +4,25 @@
 #include <flecs.h>
 #include "common.h"
 #include "components/transform.h"
+#include "components/sprite.h"
 #include "util/stb_ds.h"
 
+#define GRID_CHUNK_SIZE 16  // tiles per chunk side
+
 ecs_entity_t get_entity_at_grid_position(AppState* state, int x, int y);
 void insert_entity_to_grid(AppState* state, int x, int y, ecs_entity_t entity);
-void remove_entity_from_grid(AppState* state, int x, int y);
+void delete_entity_from_grid(AppState* state, int x, int y, ecs_entity_t entity);
 bool does_exist_in_grid(AppState* state, int x, int y);
 int world_to_tile(float pos);
+int world_to_chunk(float pos);
+
+// chunk buckets for drawable entities. track sets GridChunkRef, the render system moves
+// entities between buckets as they walk and drops them when GridChunkRef is removed
+void grid_chunk_track(AppState* state, ecs_entity_t entity, float x, float y);
+void grid_chunk_add(AppState* state, int chunk_x, int chunk_y, ecs_entity_t entity);
+void grid_chunk_remove(AppState* state, int chunk_x, int chunk_y, ecs_entity_t entity);
+ecs_entity_t* grid_chunk_entities(AppState* state, int chunk_x, int chunk_y);
+// NULL for chunks nothing was ever added to
+ChunkLod* grid_chunk_lod(AppState* state, int chunk_x, int chunk_y);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "job_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+// takes jobs until the batch runs dry. called with the lock held, returns with it held
+static void drain_jobs(JobPool* pool) {
+    while (pool->next < pool->count) {
+        int job = pool->next++;
+        JobFunc func = pool->func;
+        void* ctx = pool->ctx;
+
+        SDL_UnlockMutex(pool->lock);
+        func(ctx, job);
+        SDL_LockMutex(pool->lock);
+
+        if (--pool->remaining == 0) {
+            SDL_BroadcastCondition(pool->done);
+        }
+    }
+}
+
+static int worker_main(void* data) {
+    JobPool* pool = (JobPool*) data;
+
+    SDL_LockMutex(pool->lock);
+    while (!pool->quit) {
+        if (pool->next >= pool->count) {
+            SDL_WaitCondition(pool->work, pool->lock);
+            continue;
+        }
+        drain_jobs(pool);
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+bool job_pool_init(JobPool* pool, int thread_count) {
+    memset(pool, 0, sizeof(JobPool));
+
+    pool->lock = SDL_CreateMutex();
+    pool->work = SDL_CreateCondition();
+    pool->done = SDL_CreateCondition();
+    if (!pool->lock || !pool->work || !pool->done) {
+        fprintf(stderr, "Failed to create job pool sync: %s\n", SDL_GetError());
+        return false;
+    }
+
+    if (thread_count > JOB_POOL_MAX_THREADS) thread_count = JOB_POOL_MAX_THREADS;
+    for (int i = 0; i < thread_count; i++) {
+        pool->threads[i] = SDL_CreateThread(worker_main, "worker", pool);
+        if (!pool->threads[i]) {
+            // whatever started still helps, the caller covers the rest
+            fprintf(stderr, "Failed to create worker thread: %s\n", SDL_GetError());
+            break;
+        }
+        pool->thread_count++;
+    }
+
+    printf("Job pool started with %d worker threads\n", pool->thread_count);
+    return true;
+}
+
+void job_pool_shutdown(JobPool* pool) {
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->quit = true;
+        SDL_BroadcastCondition(pool->work);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    for (int i = 0; i < pool->thread_count; i++) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    if (pool->done) SDL_DestroyCondition(pool->done);
+    if (pool->work) SDL_DestroyCondition(pool->work);
+    if (pool->lock) SDL_DestroyMutex(pool->lock);
+    memset(pool, 0, sizeof(JobPool));
+}
+
+void job_pool_run(JobPool* pool, int count, JobFunc func, void* ctx) {
+    if (count <= 0) {
+        return;
+    }
+
+    // no pool (or a single job), nothing to hand out
+    if (!pool->lock || pool->thread_count == 0 || count == 1) {
+        for (int i = 0; i < count; i++) {
+            func(ctx, i);
+        }
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+    pool->func = func;
+    pool->ctx = ctx;
+    pool->next = 0;
+    pool->count = count;
+    pool->remaining = count;
+    SDL_BroadcastCondition(pool->work);
+
+    drain_jobs(pool);
+    while (pool->remaining > 0) {
+        SDL_WaitCondition(pool->done, pool->lock);
+    }
+    SDL_UnlockMutex(pool->lock);
+}
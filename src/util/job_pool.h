@@ -0,0 +1,41 @@
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// a handful of worker threads for parallel-for style work. jobs are coarse (one per slice of
+// the data, not one per item), so a plain mutex is enough to hand them out
+
+#define JOB_POOL_MAX_THREADS 16
+
+typedef void (*JobFunc)(void* ctx, int job);
+
+typedef struct {
+    SDL_Thread* threads[JOB_POOL_MAX_THREADS];
+    int thread_count;
+    SDL_Mutex* lock;
+    SDL_Condition* work;   // signalled when a batch is posted or on quit
+    SDL_Condition* done;   // signalled when the last job of a batch finishes
+    JobFunc func;
+    void* ctx;
+    int next;              // next job to hand out
+    int count;             // jobs in the current batch
+    int remaining;         // jobs not finished yet
+    bool quit;
+} JobPool;
+
+// thread_count can be 0, every batch then runs on the caller
+bool job_pool_init(JobPool* pool, int thread_count);
+void job_pool_shutdown(JobPool* pool);
+
+// runs func(ctx, 0 .. count-1) across the workers and the calling thread, returns once all
+// of them are done. one batch at a time, only call it from one thread
+void job_pool_run(JobPool* pool, int count, JobFunc func, void* ctx);
+
+// workers plus the caller, how many ways a batch is worth splitting
+static inline int job_pool_width(const JobPool* pool) {
+    return pool->thread_count + 1;
+}
+
+#endif
@@ -1,6 +1,209 @@
 #include "map_loader.h"
+#include <stdio.h>
+#include <string.h>
+#include "util/stb_ds.h"
+#include "util/stb_image.h"
+
+// tilesets saved outside the map only carry a path to the .tsx, which is not shipped. we
+// look for an image with the same name next to the map and assume square tiles of the
+// map's grid width, which is how the sandbox sheets are laid out
+static void resolve_image_path(const char* map_path, const char* file, char* out, size_t out_size) {
+    const char* map_dir_end = strrchr(map_path, '/');
+    int dir_len = map_dir_end ? (int)(map_dir_end - map_path + 1) : 0;
+
+    const char* base = file;
+    for (const char* c = file; *c; c++) {
+        if (*c == '/' || *c == '\\') base = c + 1;
+    }
+    snprintf(out, out_size, "%.*s%s", dir_len, map_path, base);
+}
+
+static bool load_tileset_image(MapTileset* tileset, const char* path) {
+    int channels;
+    stbi_set_flip_vertically_on_load(0);
+    unsigned char* pixels = stbi_load(path, &tileset->image_w, &tileset->image_h, &channels, 4);
+    if (!pixels) {
+        return false;
+    }
+
+    tileset->image = sg_make_image(&(sg_image_desc) {
+        .width = tileset->image_w,
+        .height = tileset->image_h,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+        .data.subimage[0][0] = {
+            .ptr = pixels,
+            .size = (size_t)tileset->image_w * tileset->image_h * 4
+        },
+        .label = "tileset"
+    });
+    stbi_image_free(pixels);
+    return true;
+}
+
+static void load_tileset(Map* map, const char* map_path, const cute_tiled_tileset_t* ts) {
+    MapTileset tileset = {
+        .firstgid = ts->firstgid,
+        .tile_w = ts->tilewidth > 0 ? ts->tilewidth : map->tiles.tile_width,
+        .tile_h = ts->tileheight > 0 ? ts->tileheight : map->tiles.tile_width,
+        .margin = ts->margin,
+        .spacing = ts->spacing,
+        .columns = ts->columns
+    };
+
+    char path[512];
+    if (ts->image.ptr && ts->image.ptr[0]) {
+        resolve_image_path(map_path, ts->image.ptr, path, sizeof(path));
+    } else if (ts->source.ptr) {
+        char file[256];
+        resolve_image_path("", ts->source.ptr, file, sizeof(file));
+        char* ext = strrchr(file, '.');
+        if (ext) *ext = '\0';
+        char png[272];
+        snprintf(png, sizeof(png), "%s.png", file);
+        resolve_image_path(map_path, png, path, sizeof(path));
+    } else {
+        path[0] = '\0';
+    }
+
+    if (!path[0] || !load_tileset_image(&tileset, path)) {
+        fprintf(stderr, "Tileset image not found for firstgid %d (%s), its tiles are skipped\n",
+                ts->firstgid, path);
+    } else if (tileset.columns <= 0) {
+        tileset.columns = (tileset.image_w - tileset.margin * 2 + tileset.spacing) / (tileset.tile_w + tileset.spacing);
+    }
+
+    arrput(map->tiles.tilesets, tileset);
+}
 
 void load_map(AppState* state, char* path) {
-    int size = 0; 
-    //cute_tiled_map_t* map = cute_tiled_load_map_from_file(path, size);
-}
\ No newline at end of file
+    Map* map = &state->map;
+    cute_tiled_map_t* tiled = cute_tiled_load_map_from_file(path, NULL);
+    if (!tiled) {
+        fprintf(stderr, "Failed to load map: %s\n", path);
+        return;
+    }
+
+    map->map_width = tiled->width;
+    map->map_height = tiled->height;
+    map->tiles.tile_width = tiled->tilewidth;
+    map->tiles.tile_height = tiled->tileheight;
+    map->tiles.isometric = tiled->orientation.ptr && strcmp(tiled->orientation.ptr, "isometric") == 0;
+
+    for (cute_tiled_tileset_t* ts = tiled->tilesets; ts; ts = ts->next) {
+        load_tileset(map, path, ts);
+    }
+
+    // only visible tile layers are kept, they are the static part of the map
+    for (cute_tiled_layer_t* layer = tiled->layers; layer; layer = layer->next) {
+        if (!layer->type.ptr || strcmp(layer->type.ptr, "tilelayer") != 0 || !layer->visible) {
+            continue;
+        }
+        if (layer->data_count != map->map_width * map->map_height) {
+            fprintf(stderr, "Skipping layer %s, size does not match the map\n", layer->name.ptr);
+            continue;
+        }
+
+        MapLayer l = {0};
+        strncpy(l.name, layer->name.ptr ? layer->name.ptr : "", sizeof(l.name) - 1);
+        l.gids = malloc(layer->data_count * sizeof(uint32_t));
+        for (int i = 0; i < layer->data_count; i++) {
+            l.gids[i] = (uint32_t)layer->data[i] & TILEMAP_GID_MASK;
+        }
+        arrput(map->tiles.layers, l);
+    }
+
+    map->tiles.chunks_x = (map->map_width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    map->tiles.chunks_y = (map->map_height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    map->tiles.chunks = calloc((size_t)map->tiles.chunks_x * map->tiles.chunks_y, sizeof(MapChunk));
+    for (int i = 0; i < map->tiles.chunks_x * map->tiles.chunks_y; i++) {
+        map->tiles.chunks[i].dirty = true;
+    }
+
+    printf("Loaded map %s: %dx%d, %d layers, %d tilesets\n", path, map->map_width, map->map_height,
+           (int)arrlen(map->tiles.layers), (int)arrlen(map->tiles.tilesets));
+    cute_tiled_free_map(tiled);
+}
+
+void map_free(Map* map) {
+    for (int i = 0; i < arrlen(map->tiles.layers); i++) {
+        free(map->tiles.layers[i].gids);
+    }
+    arrfree(map->tiles.layers);
+
+    for (int i = 0; i < arrlen(map->tiles.tilesets); i++) {
+        sg_destroy_image(map->tiles.tilesets[i].image);
+    }
+    arrfree(map->tiles.tilesets);
+
+    for (int i = 0; i < map->tiles.chunks_x * map->tiles.chunks_y; i++) {
+        sg_destroy_buffer(map->tiles.chunks[i].buffer);
+        arrfree(map->tiles.chunks[i].runs);
+    }
+    free(map->tiles.chunks);
+    map->tiles.chunks = NULL;
+}
+
+uint32_t map_get_tile(const Map* map, int layer, int tile_x, int tile_y) {
+    if (layer < 0 || layer >= arrlen(map->tiles.layers) ||
+        tile_x < 0 || tile_y < 0 || tile_x >= map->map_width || tile_y >= map->map_height) {
+        return 0;
+    }
+    return map->tiles.layers[layer].gids[tile_y * map->map_width + tile_x];
+}
+
+void map_set_tile(Map* map, int layer, int tile_x, int tile_y, uint32_t gid) {
+    if (layer < 0 || layer >= arrlen(map->tiles.layers) ||
+        tile_x < 0 || tile_y < 0 || tile_x >= map->map_width || tile_y >= map->map_height) {
+        return;
+    }
+    uint32_t* slot = &map->tiles.layers[layer].gids[tile_y * map->map_width + tile_x];
+    if (*slot == (gid & TILEMAP_GID_MASK)) {
+        return;
+    }
+    *slot = gid & TILEMAP_GID_MASK;
+
+    int cx = tile_x / TILEMAP_CHUNK_SIZE;
+    int cy = tile_y / TILEMAP_CHUNK_SIZE;
+    map->tiles.chunks[cy * map->tiles.chunks_x + cx].dirty = true;
+}
+
+void map_tile_to_world(const Map* map, int tile_x, int tile_y, float* x, float* y) {
+    const TileMap* t = &map->tiles;
+    if (t->isometric) {
+        // diamond layout, shifted right so the left-most tile starts at x = 0
+        *x = (tile_x - tile_y + map->map_height - 1) * t->tile_width * 0.5f;
+        *y = (tile_x + tile_y) * t->tile_height * 0.5f;
+    } else {
+        *x = (float)(tile_x * t->tile_width);
+        *y = (float)(tile_y * t->tile_height);
+    }
+}
+
+void map_grid_to_iso(const Map* map, float x, float y, float* sx, float* sy) {
+    const TileMap* t = &map->tiles;
+    float tx = x / TILE_SIZE, ty = y / TILE_SIZE;
+    // tile corner (tx, ty) is the top point of that tile's diamond
+    *sx = (tx - ty + map->map_height) * t->tile_width * 0.5f;
+    *sy = (tx + ty) * t->tile_height * 0.5f;
+}
+
+void map_iso_to_grid(const Map* map, float sx, float sy, float* x, float* y) {
+    const TileMap* t = &map->tiles;
+    float a = sx / (t->tile_width * 0.5f) - map->map_height;  // tx - ty
+    float b = sy / (t->tile_height * 0.5f);                   // tx + ty
+    *x = (a + b) * 0.5f * TILE_SIZE;
+    *y = (b - a) * 0.5f * TILE_SIZE;
+}
+
+void map_grid_rect_to_iso(const Map* map, float x, float y, float w, float h, float out[4]) {
+    // the rect's top-left corner becomes the diamond's top point, bottom-left its left point
+    float top_x, top_y, left_x, left_y, right_x, right_y, bottom_x, bottom_y;
+    map_grid_to_iso(map, x, y, &top_x, &top_y);
+    map_grid_to_iso(map, x, y + h, &left_x, &left_y);
+    map_grid_to_iso(map, x + w, y, &right_x, &right_y);
+    map_grid_to_iso(map, x + w, y + h, &bottom_x, &bottom_y);
+    out[0] = left_x;
+    out[1] = top_y;
+    out[2] = right_x - left_x;
+    out[3] = bottom_y - top_y;
+}
@@ -6,5 +6,20 @@
 #include "cute_tiled.h"
 
 void load_map(AppState* state, char* path);
+void map_free(Map* map);
 
-#endif
\ No newline at end of file
+uint32_t map_get_tile(const Map* map, int layer, int tile_x, int tile_y);
+// changes a tile and marks its chunk for rebaking
+void map_set_tile(Map* map, int layer, int tile_x, int tile_y, uint32_t gid);
+
+// world position of the top-left of a tile's footprint on the map grid
+void map_tile_to_world(const Map* map, int tile_x, int tile_y, float* x, float* y);
+
+// isometric maps are drawn as diamonds while entities live on the square build grid
+// (TILE_SIZE per tile). these go between a grid position and the plane the map is drawn on
+void map_grid_to_iso(const Map* map, float x, float y, float* sx, float* sy);
+void map_iso_to_grid(const Map* map, float sx, float sy, float* x, float* y);
+// a rect on the grid lands on the plane as a diamond, this is the rect around it
+void map_grid_rect_to_iso(const Map* map, float x, float y, float w, float h, float out[4]);
+
+#endif
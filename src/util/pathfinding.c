@@ -0,0 +1,555 @@
+#include "util/pathfinding.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "util/stb_ds.h"
+
+#define CHUNK_TILES (PATH_CHUNK_SIZE * PATH_CHUNK_SIZE)
+
+enum { SIDE_EAST, SIDE_WEST, SIDE_SOUTH, SIDE_NORTH };
+static const int step_x[4] = { 1, -1, 0, 0 };
+static const int step_y[4] = { 0, 0, 1, -1 };
+
+typedef struct {
+    uint32_t f;
+    int id;
+} HeapItem;
+
+static inline bool in_bounds(const PathGraph *pf, int x, int y) {
+    return x >= 0 && y >= 0 && x < pf->width && y < pf->height;
+}
+
+static inline bool walkable(const PathGraph *pf, int x, int y) {
+    return in_bounds(pf, x, y) && !pf->blocked[y * pf->width + x];
+}
+
+static inline int chunk_of(const PathGraph *pf, int x, int y) {
+    return (y / PATH_CHUNK_SIZE) * pf->chunks_x + x / PATH_CHUNK_SIZE;
+}
+
+static inline int manhattan(PathPoint a, PathPoint b) {
+    return abs(a.x - b.x) + abs(a.y - b.y);
+}
+
+static void chunk_bounds(const PathGraph *pf, int chunk, int *x0, int *y0, int *x1, int *y1) {
+    int cx = chunk % pf->chunks_x;
+    int cy = chunk / pf->chunks_x;
+    *x0 = cx * PATH_CHUNK_SIZE;
+    *y0 = cy * PATH_CHUNK_SIZE;
+    *x1 = *x0 + PATH_CHUNK_SIZE < pf->width ? *x0 + PATH_CHUNK_SIZE : pf->width;
+    *y1 = *y0 + PATH_CHUNK_SIZE < pf->height ? *y0 + PATH_CHUNK_SIZE : pf->height;
+}
+
+// tile index inside its chunk, used for the per-chunk distance tables
+static inline int chunk_local(PathPoint p) {
+    return (p.y % PATH_CHUNK_SIZE) * PATH_CHUNK_SIZE + (p.x % PATH_CHUNK_SIZE);
+}
+
+static void heap_push(HeapItem **heap, uint32_t f, int id) {
+    arrput(*heap, ((HeapItem){ f, id }));
+    HeapItem *h = *heap;
+    int i = (int)arrlen(h) - 1;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (h[parent].f <= h[i].f) break;
+        HeapItem tmp = h[parent];
+        h[parent] = h[i];
+        h[i] = tmp;
+        i = parent;
+    }
+}
+
+static HeapItem heap_pop(HeapItem **heap) {
+    HeapItem *h = *heap;
+    HeapItem top = h[0];
+    h[0] = arrpop(h);
+    int n = (int)arrlen(h);
+    int i = 0;
+    for (;;) {
+        int l = i * 2 + 1, r = l + 1, best = i;
+        if (l < n && h[l].f < h[best].f) best = l;
+        if (r < n && h[r].f < h[best].f) best = r;
+        if (best == i) break;
+        HeapItem tmp = h[best];
+        h[best] = h[i];
+        h[i] = tmp;
+        i = best;
+    }
+    *heap = h;
+    return top;
+}
+
+// exact A* restricted to the tile box [x0, x1) x [y0, y1).
+// appends every tile after from up to and including to.
+static bool local_search(PathGraph *pf, int x0, int y0, int x1, int y1,
+                         PathPoint from, PathPoint to, PathPoint **out) {
+    int bw = x1 - x0;
+    int bh = y1 - y0;
+    if (from.x < x0 || from.x >= x1 || from.y < y0 || from.y >= y1 ||
+        to.x < x0 || to.x >= x1 || to.y < y0 || to.y >= y1) {
+        return false;
+    }
+
+    int count = bw * bh;
+    uint32_t *g = malloc(count * sizeof(uint32_t));
+    int *parent = malloc(count * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        g[i] = UINT32_MAX;
+        parent[i] = -1;
+    }
+
+    int start = (from.y - y0) * bw + (from.x - x0);
+    int goal = (to.y - y0) * bw + (to.x - x0);
+    HeapItem *open = NULL;
+    g[start] = 0;
+    heap_push(&open, manhattan(from, to), start);
+
+    bool found = false;
+    while (arrlen(open) > 0) {
+        HeapItem item = heap_pop(&open);
+        int idx = item.id;
+        if (idx == goal) {
+            found = true;
+            break;
+        }
+
+        PathPoint p = { idx % bw + x0, idx / bw + y0 };
+        if (item.f != g[idx] + manhattan(p, to)) continue;  // stale entry
+
+        for (int d = 0; d < 4; d++) {
+            PathPoint n = { p.x + step_x[d], p.y + step_y[d] };
+            if (n.x < x0 || n.x >= x1 || n.y < y0 || n.y >= y1) continue;
+            if (!walkable(pf, n.x, n.y)) continue;
+
+            int nidx = (n.y - y0) * bw + (n.x - x0);
+            uint32_t ng = g[idx] + 1;
+            if (ng < g[nidx]) {
+                g[nidx] = ng;
+                parent[nidx] = idx;
+                heap_push(&open, ng + manhattan(n, to), nidx);
+            }
+        }
+    }
+
+    if (found) {
+        int len = (int)g[goal];
+        int base = (int)arrlen(*out);
+        arraddnptr(*out, len);
+        for (int idx = goal, i = len - 1; idx != start; idx = parent[idx], i--) {
+            (*out)[base + i] = (PathPoint){ idx % bw + x0, idx / bw + y0 };
+        }
+    }
+
+    arrfree(open);
+    free(parent);
+    free(g);
+    return found;
+}
+
+// walking cost from one tile to every tile of its chunk without leaving the chunk
+static void chunk_bfs(const PathGraph *pf, int chunk, PathPoint from, uint16_t dist[CHUNK_TILES]) {
+    int x0, y0, x1, y1;
+    chunk_bounds(pf, chunk, &x0, &y0, &x1, &y1);
+
+    for (int i = 0; i < CHUNK_TILES; i++) {
+        dist[i] = PATH_UNREACHABLE;
+    }
+    if (!walkable(pf, from.x, from.y)) return;
+
+    int queue[CHUNK_TILES];
+    int head = 0, tail = 0;
+    dist[chunk_local(from)] = 0;
+    queue[tail++] = chunk_local(from);
+
+    while (head < tail) {
+        int local = queue[head++];
+        PathPoint p = { x0 + local % PATH_CHUNK_SIZE, y0 + local / PATH_CHUNK_SIZE };
+
+        for (int d = 0; d < 4; d++) {
+            PathPoint n = { p.x + step_x[d], p.y + step_y[d] };
+            if (n.x < x0 || n.x >= x1 || n.y < y0 || n.y >= y1) continue;
+            if (!walkable(pf, n.x, n.y)) continue;
+
+            int nlocal = chunk_local(n);
+            if (dist[nlocal] != PATH_UNREACHABLE) continue;
+            dist[nlocal] = dist[local] + 1;
+            queue[tail++] = nlocal;
+        }
+    }
+}
+
+static int chunk_find_node(const PathChunk *chunk, PathPoint p) {
+    for (int i = 0; i < chunk->node_count; i++) {
+        if (chunk->nodes[i].x == p.x && chunk->nodes[i].y == p.y) return i;
+    }
+    return -1;
+}
+
+// portals along one side of a chunk. a portal sits in the middle of every run of tiles
+// that are walkable on both sides of the border, so the neighbouring chunk derives the
+// mirrored portal from the same run and the two line up without any shared state.
+static void collect_side_portals(PathGraph *pf, int chunk_index, int side) {
+    PathChunk *chunk = &pf->chunks[chunk_index];
+    int x0, y0, x1, y1;
+    chunk_bounds(pf, chunk_index, &x0, &y0, &x1, &y1);
+
+    int length;
+    PathPoint origin;
+    int along_x, along_y;
+    switch (side) {
+        case SIDE_EAST:  origin = (PathPoint){ x1 - 1, y0 }; along_x = 0; along_y = 1; length = y1 - y0; break;
+        case SIDE_WEST:  origin = (PathPoint){ x0, y0 };     along_x = 0; along_y = 1; length = y1 - y0; break;
+        case SIDE_SOUTH: origin = (PathPoint){ x0, y1 - 1 }; along_x = 1; along_y = 0; length = x1 - x0; break;
+        default:         origin = (PathPoint){ x0, y0 };     along_x = 1; along_y = 0; length = x1 - x0; break;
+    }
+
+    int run_start = -1;
+    for (int i = 0; i <= length; i++) {
+        bool open = false;
+        if (i < length) {
+            int ix = origin.x + along_x * i;
+            int iy = origin.y + along_y * i;
+            open = walkable(pf, ix, iy) && walkable(pf, ix + step_x[side], iy + step_y[side]);
+        }
+
+        if (open && run_start < 0) {
+            run_start = i;
+        } else if (!open && run_start >= 0) {
+            int mid = run_start + (i - run_start) / 2;
+            PathPoint p = { origin.x + along_x * mid, origin.y + along_y * mid };
+            if (chunk->node_count < PATH_MAX_CHUNK_NODES && chunk_find_node(chunk, p) < 0) {
+                chunk->nodes[chunk->node_count++] = p;
+            }
+            run_start = -1;
+        }
+    }
+}
+
+static void rebuild_chunk(PathGraph *pf, int chunk_index) {
+    PathChunk *chunk = &pf->chunks[chunk_index];
+    chunk->node_count = 0;
+    for (int side = 0; side < 4; side++) {
+        collect_side_portals(pf, chunk_index, side);
+    }
+
+    uint16_t dist[CHUNK_TILES];
+    for (int i = 0; i < chunk->node_count; i++) {
+        chunk_bfs(pf, chunk_index, chunk->nodes[i], dist);
+        for (int j = 0; j < chunk->node_count; j++) {
+            chunk->dist[i][j] = dist[chunk_local(chunk->nodes[j])];
+        }
+    }
+    chunk->dirty = false;
+}
+
+static void mark_chunk_dirty(PathGraph *pf, int chunk_index) {
+    if (pf->chunks[chunk_index].dirty) return;
+    pf->chunks[chunk_index].dirty = true;
+    arrput(pf->dirty_chunks, chunk_index);
+}
+
+bool pathfinding_init(PathGraph *pf, int width, int height) {
+    memset(pf, 0, sizeof(PathGraph));
+    pf->width = width > 0 ? width : PATH_DEFAULT_MAP_SIZE;
+    pf->height = height > 0 ? height : PATH_DEFAULT_MAP_SIZE;
+    pf->chunks_x = (pf->width + PATH_CHUNK_SIZE - 1) / PATH_CHUNK_SIZE;
+    pf->chunks_y = (pf->height + PATH_CHUNK_SIZE - 1) / PATH_CHUNK_SIZE;
+
+    int chunk_count = pf->chunks_x * pf->chunks_y;
+    int node_slots = chunk_count * PATH_MAX_CHUNK_NODES + 2;  // + virtual start and goal
+
+    pf->blocked = calloc(pf->width * pf->height, 1);
+    pf->chunks = calloc(chunk_count, sizeof(PathChunk));
+    pf->search_stamp = calloc(node_slots, sizeof(uint32_t));
+    pf->search_g = calloc(node_slots, sizeof(uint32_t));
+    pf->search_parent = calloc(node_slots, sizeof(int));
+
+    if (!pf->blocked || !pf->chunks || !pf->search_stamp || !pf->search_g || !pf->search_parent) {
+        fprintf(stderr, "Failed to allocate pathfinding grid (%dx%d)\n", pf->width, pf->height);
+        pathfinding_shutdown(pf);
+        return false;
+    }
+
+    for (int i = 0; i < chunk_count; i++) {
+        mark_chunk_dirty(pf, i);
+    }
+    pathfinding_update(pf);
+    return true;
+}
+
+static void route_free(PathRoute *route) {
+    arrfree(route->points);
+    arrfree(route->chunks);
+    arrfree(route->versions);
+}
+
+static void route_cache_clear(PathGraph *pf) {
+    for (int i = 0; i < hmlen(pf->routes); i++) {
+        route_free(&pf->routes[i].value);
+    }
+    hmfree(pf->routes);
+}
+
+void pathfinding_shutdown(PathGraph *pf) {
+    route_cache_clear(pf);
+    arrfree(pf->dirty_chunks);
+    free(pf->blocked);
+    free(pf->chunks);
+    free(pf->search_stamp);
+    free(pf->search_g);
+    free(pf->search_parent);
+    memset(pf, 0, sizeof(PathGraph));
+}
+
+bool pathfinding_is_blocked(const PathGraph *pf, int tile_x, int tile_y) {
+    return !walkable(pf, tile_x, tile_y);
+}
+
+void pathfinding_set_blocked(PathGraph *pf, int tile_x, int tile_y, bool blocked) {
+    if (!pf->blocked || !in_bounds(pf, tile_x, tile_y)) return;
+
+    uint8_t *tile = &pf->blocked[tile_y * pf->width + tile_x];
+    if (*tile == (uint8_t)blocked) return;
+    *tile = blocked;
+
+    int chunk_index = chunk_of(pf, tile_x, tile_y);
+    pf->chunks[chunk_index].version++;
+    mark_chunk_dirty(pf, chunk_index);
+
+    // portals on a shared border depend on the tiles of both chunks
+    for (int d = 0; d < 4; d++) {
+        int nx = tile_x + step_x[d];
+        int ny = tile_y + step_y[d];
+        if (!in_bounds(pf, nx, ny)) continue;
+        int neighbour = chunk_of(pf, nx, ny);
+        if (neighbour != chunk_index) {
+            mark_chunk_dirty(pf, neighbour);
+        }
+    }
+}
+
+void pathfinding_update(PathGraph *pf) {
+    for (int i = 0; i < arrlen(pf->dirty_chunks); i++) {
+        rebuild_chunk(pf, pf->dirty_chunks[i]);
+    }
+    arrsetlen(pf->dirty_chunks, 0);
+}
+
+static inline uint32_t search_g(const PathGraph *pf, int id) {
+    return pf->search_stamp[id] == pf->stamp ? pf->search_g[id] : UINT32_MAX;
+}
+
+static void search_relax(PathGraph *pf, HeapItem **open, int id, int parent, uint32_t g,
+                         PathPoint tile, PathPoint goal) {
+    if (g >= search_g(pf, id)) return;
+    pf->search_stamp[id] = pf->stamp;
+    pf->search_g[id] = g;
+    pf->search_parent[id] = parent;
+    heap_push(open, g + manhattan(tile, goal), id);
+}
+
+// A* over the portal graph with the start and goal tiles hooked in as virtual nodes.
+// fills waypoints with start, the portals crossed, and goal.
+static bool abstract_search(PathGraph *pf, PathPoint start, PathPoint goal, PathPoint **waypoints) {
+    int slots = pf->chunks_x * pf->chunks_y * PATH_MAX_CHUNK_NODES;
+    int start_id = slots;
+    int goal_id = slots + 1;
+    int start_chunk = chunk_of(pf, start.x, start.y);
+    int goal_chunk = chunk_of(pf, goal.x, goal.y);
+
+    uint16_t start_dist[CHUNK_TILES];
+    uint16_t goal_dist[CHUNK_TILES];
+    chunk_bfs(pf, start_chunk, start, start_dist);
+    chunk_bfs(pf, goal_chunk, goal, goal_dist);
+
+    pf->stamp++;
+    HeapItem *open = NULL;
+    search_relax(pf, &open, start_id, -1, 0, start, goal);
+
+    bool found = false;
+    while (arrlen(open) > 0) {
+        HeapItem item = heap_pop(&open);
+        int id = item.id;
+        if (id == goal_id) {
+            found = true;
+            break;
+        }
+
+        uint32_t g = search_g(pf, id);
+        if (id == start_id) {
+            const PathChunk *chunk = &pf->chunks[start_chunk];
+            for (int i = 0; i < chunk->node_count; i++) {
+                uint16_t d = start_dist[chunk_local(chunk->nodes[i])];
+                if (d == PATH_UNREACHABLE) continue;
+                search_relax(pf, &open, start_chunk * PATH_MAX_CHUNK_NODES + i, id, g + d, chunk->nodes[i], goal);
+            }
+            if (start_chunk == goal_chunk && start_dist[chunk_local(goal)] != PATH_UNREACHABLE) {
+                search_relax(pf, &open, goal_id, id, g + start_dist[chunk_local(goal)], goal, goal);
+            }
+            continue;
+        }
+
+        int chunk_index = id / PATH_MAX_CHUNK_NODES;
+        int node = id % PATH_MAX_CHUNK_NODES;
+        const PathChunk *chunk = &pf->chunks[chunk_index];
+        PathPoint p = chunk->nodes[node];
+        if (item.f != g + manhattan(p, goal)) continue;  // stale entry
+
+        for (int j = 0; j < chunk->node_count; j++) {
+            uint16_t d = chunk->dist[node][j];
+            if (j == node || d == PATH_UNREACHABLE) continue;
+            search_relax(pf, &open, chunk_index * PATH_MAX_CHUNK_NODES + j, id, g + d, chunk->nodes[j], goal);
+        }
+
+        // the mirrored portal across each border this tile sits on
+        for (int d = 0; d < 4; d++) {
+            PathPoint n = { p.x + step_x[d], p.y + step_y[d] };
+            if (!walkable(pf, n.x, n.y)) continue;
+            int other = chunk_of(pf, n.x, n.y);
+            if (other == chunk_index) continue;
+            int j = chunk_find_node(&pf->chunks[other], n);
+            if (j < 0) continue;
+            search_relax(pf, &open, other * PATH_MAX_CHUNK_NODES + j, id, g + 1, n, goal);
+        }
+
+        if (chunk_index == goal_chunk && goal_dist[chunk_local(p)] != PATH_UNREACHABLE) {
+            search_relax(pf, &open, goal_id, id, g + goal_dist[chunk_local(p)], goal, goal);
+        }
+    }
+    arrfree(open);
+
+    if (!found) return false;
+
+    // walk the parents back from the goal, then flip into start -> goal order
+    arrsetlen(*waypoints, 0);
+    for (int id = goal_id; id != -1; id = pf->search_parent[id]) {
+        PathPoint p;
+        if (id == goal_id) p = goal;
+        else if (id == start_id) p = start;
+        else p = pf->chunks[id / PATH_MAX_CHUNK_NODES].nodes[id % PATH_MAX_CHUNK_NODES];
+        arrput(*waypoints, p);
+    }
+    int n = (int)arrlen(*waypoints);
+    for (int i = 0; i < n / 2; i++) {
+        PathPoint tmp = (*waypoints)[i];
+        (*waypoints)[i] = (*waypoints)[n - 1 - i];
+        (*waypoints)[n - 1 - i] = tmp;
+    }
+    return true;
+}
+
+bool pathfinding_refine_segment(PathGraph *pf, PathPoint from, PathPoint to, PathPoint **out) {
+    if (manhattan(from, to) == 1) {
+        arrput(*out, to);
+        return true;
+    }
+
+    int chunk_index = chunk_of(pf, from.x, from.y);
+    if (chunk_index != chunk_of(pf, to.x, to.y)) return false;
+
+    pathfinding_update(pf);
+    int x0, y0, x1, y1;
+    chunk_bounds(pf, chunk_index, &x0, &y0, &x1, &y1);
+    return local_search(pf, x0, y0, x1, y1, from, to, out);
+}
+
+static bool route_is_valid(const PathGraph *pf, const PathRoute *route) {
+    for (int i = 0; i < arrlen(route->chunks); i++) {
+        if (pf->chunks[route->chunks[i]].version != route->versions[i]) return false;
+    }
+    return true;
+}
+
+static void route_record_chunks(const PathGraph *pf, PathRoute *route) {
+    for (int i = 0; i < arrlen(route->points); i++) {
+        int chunk_index = chunk_of(pf, route->points[i].x, route->points[i].y);
+        bool seen = false;
+        for (int j = 0; j < arrlen(route->chunks); j++) {
+            if (route->chunks[j] == chunk_index) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            arrput(route->chunks, chunk_index);
+            arrput(route->versions, pf->chunks[chunk_index].version);
+        }
+    }
+}
+
+static void copy_points(PathPoint **out, const PathPoint *points) {
+    arrsetlen(*out, arrlen(points));
+    if (arrlen(points) > 0) {
+        memcpy(*out, points, arrlen(points) * sizeof(PathPoint));
+    }
+}
+
+bool pathfinding_find_path(PathGraph *pf, PathPoint start, PathPoint goal, PathPoint **out) {
+    arrsetlen(*out, 0);
+    if (!walkable(pf, start.x, start.y) || !walkable(pf, goal.x, goal.y)) return false;
+
+    pathfinding_update(pf);
+
+    uint64_t key = ((uint64_t)(uint32_t)(start.y * pf->width + start.x) << 32) |
+                   (uint32_t)(goal.y * pf->width + goal.x);
+    PathRouteEntry *cached = hmgetp_null(pf->routes, key);
+    if (cached) {
+        if (route_is_valid(pf, &cached->value)) {
+            copy_points(out, cached->value.points);
+            return true;
+        }
+        route_free(&cached->value);
+        hmdel(pf->routes, key);
+    }
+
+    PathRoute route = {0};
+    arrput(route.points, start);
+    bool found = start.x == goal.x && start.y == goal.y;
+
+    // close by: a plain A* over the chunks around both ends is cheaper than the abstract search
+    int start_chunk = chunk_of(pf, start.x, start.y);
+    int goal_chunk = chunk_of(pf, goal.x, goal.y);
+    int scx = start_chunk % pf->chunks_x, scy = start_chunk / pf->chunks_x;
+    int gcx = goal_chunk % pf->chunks_x, gcy = goal_chunk / pf->chunks_x;
+    if (!found && abs(scx - gcx) <= 1 && abs(scy - gcy) <= 1) {
+        int x0 = (scx < gcx ? scx : gcx) * PATH_CHUNK_SIZE;
+        int y0 = (scy < gcy ? scy : gcy) * PATH_CHUNK_SIZE;
+        int x1 = ((scx > gcx ? scx : gcx) + 1) * PATH_CHUNK_SIZE;
+        int y1 = ((scy > gcy ? scy : gcy) + 1) * PATH_CHUNK_SIZE;
+        if (x1 > pf->width) x1 = pf->width;
+        if (y1 > pf->height) y1 = pf->height;
+        found = local_search(pf, x0, y0, x1, y1, start, goal, &route.points);
+        if (!found) arrsetlen(route.points, 1);
+    }
+
+    if (!found) {
+        PathPoint *waypoints = NULL;
+        found = abstract_search(pf, start, goal, &waypoints);
+        int n = (int)arrlen(waypoints);
+
+        // exact tiles for the first and last legs, portals in between
+        if (found && n == 2) {
+            found = pathfinding_refine_segment(pf, start, goal, &route.points);
+        } else if (found) {
+            found = pathfinding_refine_segment(pf, start, waypoints[1], &route.points);
+            for (int i = 2; found && i < n - 1; i++) {
+                arrput(route.points, waypoints[i]);
+            }
+            found = found && pathfinding_refine_segment(pf, waypoints[n - 2], goal, &route.points);
+        }
+        arrfree(waypoints);
+    }
+
+    if (!found) {
+        route_free(&route);
+        return false;
+    }
+
+    route_record_chunks(pf, &route);
+    if (hmlen(pf->routes) >= PATH_ROUTE_CACHE_SIZE) {
+        route_cache_clear(pf);
+    }
+    hmput(pf->routes, key, route);
+    copy_points(out, route.points);
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// hierarchical pathfinding (HPA*) over the tile grid.
+// the map is split into chunks, each chunk keeps a handful of portal tiles on its
+// borders plus the walking cost between them. long routes are searched on that small
+// abstract graph and only the ends near the start and goal are refined to exact tiles.
+// placing / removing a building only rebuilds the chunk it sits in.
+
+#define PATH_CHUNK_SIZE 16
+#define PATH_MAX_CHUNK_NODES 32      // one portal per border run, at most 8 runs per side
+#define PATH_DEFAULT_MAP_SIZE 100    // used until the map loader provides real dimensions
+#define PATH_ROUTE_CACHE_SIZE 256
+#define PATH_UNREACHABLE 0xFFFF
+
+typedef struct {
+    int x, y;  // tile coordinates
+} PathPoint;
+
+typedef struct {
+    PathPoint nodes[PATH_MAX_CHUNK_NODES];                      // portal tiles inside this chunk
+    uint16_t dist[PATH_MAX_CHUNK_NODES][PATH_MAX_CHUNK_NODES];  // intra-chunk walking cost
+    int node_count;
+    uint32_t version;  // bumped whenever a tile in the chunk changes
+    bool dirty;
+} PathChunk;
+
+// a cached route is valid as long as none of the chunks it crosses changed
+typedef struct {
+    PathPoint *points;   // stb_ds array
+    int *chunks;         // stb_ds array of chunk indices the route crosses
+    uint32_t *versions;  // chunk versions at the time the route was found
+} PathRoute;
+
+typedef struct {
+    uint64_t key;
+    PathRoute value;
+} PathRouteEntry;
+
+typedef struct {
+    int width, height;             // in tiles
+    int chunks_x, chunks_y;
+    uint8_t *blocked;              // one byte per tile
+    PathChunk *chunks;
+    int *dirty_chunks;             // stb_ds array of chunks waiting for a rebuild
+
+    // scratch for the abstract search, indexed by chunk * PATH_MAX_CHUNK_NODES + node
+    uint32_t *search_stamp;
+    uint32_t *search_g;
+    int *search_parent;
+    uint32_t stamp;
+
+    PathRouteEntry *routes;        // stb_ds hashmap keyed by start / goal pair
+} PathGraph;
+
+bool pathfinding_init(PathGraph *pf, int width, int height);
+void pathfinding_shutdown(PathGraph *pf);
+
+// mark a tile as (un)walkable, called by the grid helper when buildings come and go
+void pathfinding_set_blocked(PathGraph *pf, int tile_x, int tile_y, bool blocked);
+bool pathfinding_is_blocked(const PathGraph *pf, int tile_x, int tile_y);
+
+// rebuild portals / costs for chunks touched since the last update
+void pathfinding_update(PathGraph *pf);
+
+// find a route from start to goal. the returned points are exact tiles in the start and
+// goal chunks and portal waypoints in between; use pathfinding_refine_segment to expand
+// the next leg when a follower reaches it. out is an stb_ds array and is reset first.
+bool pathfinding_find_path(PathGraph *pf, PathPoint start, PathPoint goal, PathPoint **out);
+
+// exact tile path between two waypoints that share a chunk (or are adjacent tiles).
+// appends every tile after from up to and including to.
+bool pathfinding_refine_segment(PathGraph *pf, PathPoint from, PathPoint to, PathPoint **out);
+
+#endif
@@ -0,0 +1,55 @@
+#include "radix_sort.h"
+#include <string.h>
+
+void radix_sort_u64(uint64_t* keys, uint32_t* values, uint64_t* tmp_keys, uint32_t* tmp_values, int count) {
+    if (count < 2) {
+        return;
+    }
+
+    // all eight histograms in one read of the keys
+    uint32_t histogram[8][256];
+    memset(histogram, 0, sizeof(histogram));
+    for (int i = 0; i < count; i++) {
+        uint64_t k = keys[i];
+        for (int b = 0; b < 8; b++) {
+            histogram[b][(k >> (b * 8)) & 0xFF]++;
+        }
+    }
+
+    uint64_t* src_k = keys;
+    uint32_t* src_v = values;
+    uint64_t* dst_k = tmp_keys;
+    uint32_t* dst_v = tmp_values;
+
+    for (int b = 0; b < 8; b++) {
+        uint32_t* h = histogram[b];
+        int shift = b * 8;
+
+        // every key has the same byte here, nothing to do
+        if (h[(src_k[0] >> shift) & 0xFF] == (uint32_t)count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (int i = 0; i < 256; i++) {
+            uint32_t c = h[i];
+            h[i] = offset;
+            offset += c;
+        }
+
+        for (int i = 0; i < count; i++) {
+            uint32_t slot = h[(src_k[i] >> shift) & 0xFF]++;
+            dst_k[slot] = src_k[i];
+            dst_v[slot] = src_v[i];
+        }
+
+        uint64_t* swap_k = src_k; src_k = dst_k; dst_k = swap_k;
+        uint32_t* swap_v = src_v; src_v = dst_v; dst_v = swap_v;
+    }
+
+    // an odd number of passes leaves the result in the scratch buffers
+    if (src_k != keys) {
+        memcpy(keys, src_k, (size_t)count * sizeof(uint64_t));
+        memcpy(values, src_v, (size_t)count * sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <stdint.h>
+
+// stable LSD radix sort of 64-bit keys, values are moved along with their key.
+// tmp_keys / tmp_values must hold count elements. bytes that are the same in every key
+// are skipped, so keys that only use a few bits cost a few passes
+void radix_sort_u64(uint64_t* keys, uint32_t* values, uint64_t* tmp_keys, uint32_t* tmp_values, int count);
+
+#endif
@@ -2,35 +2,274 @@
 #include <stdlib.h>
 #include <string.h>
 #include "util/stb_image.h"
+#include "util/stb_ds.h"
 #include "cJSON.h"
 
-sg_image load_texture(char* path) {
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(0);
-    unsigned char* data = stbi_load(path, &width, &height, &channels, 4);
+// a clip sheet waiting to be packed
+typedef struct {
+    char path[256];
+    unsigned char* pixels;
+    unsigned char* indices;  // palette index per pixel, NULL if the sheet stays rgba
+    int width, height;
+    int page, x, y;
+} PendingSheet;
+
+typedef struct {
+    uint32_t key;
+    int value;
+} PaletteEntry;
 
-    if (!data) {
+typedef struct {
+    LoadedAnimationClip* clip;
+    int sheet;
+} PendingClip;
+
+// sheets are loaded into memory while the definitions are parsed and uploaded once packed.
+// clips that share a texture file share the sheet
+static int load_sheet(PendingSheet** sheets, const char* path) {
+    for (int i = 0; i < arrlen(*sheets); i++) {
+        if (strcmp((*sheets)[i].path, path) == 0) {
+            return i;
+        }
+    }
+
+    PendingSheet sheet = { .page = -1 };
+    int channels;
+    stbi_set_flip_vertically_on_load(0);
+    sheet.pixels = stbi_load(path, &sheet.width, &sheet.height, &channels, 4);
+    if (!sheet.pixels) {
         fprintf(stderr, "Failed to load texture: %s\n", path);
-        return (sg_image){0};
+        return -1;
+    }
+    strncpy(sheet.path, path, sizeof(sheet.path) - 1);
+    arrput(*sheets, sheet);
+    return (int)arrlen(*sheets) - 1;
+}
+
+static inline uint32_t pack_colour(const unsigned char* rgba) {
+    uint32_t c;
+    memcpy(&c, rgba, sizeof(c));
+    return c;
+}
+
+// gives every sheet whose colours still fit in the shared palette an index per pixel. fully
+// transparent pixels are all index 0, whatever their rgb. a sheet that would overflow the
+// palette takes back the colours it added and stays rgba
+static void index_sheets(SpriteAtlas* atlas, PendingSheet* sheets) {
+    PaletteEntry* lookup = NULL;
+    uint32_t* row = atlas->palettes[0];
+    row[0] = 0;
+    atlas->palette_colours = 1;
+    int indexed = 0;
+
+    for (int s = 0; s < arrlen(sheets); s++) {
+        PendingSheet* sheet = &sheets[s];
+        size_t pixels = (size_t)sheet->width * sheet->height;
+        int first_new = atlas->palette_colours;
+        unsigned char* indices = malloc(pixels);
+        bool fits = true;
+
+        for (size_t i = 0; i < pixels && fits; i++) {
+            const unsigned char* px = sheet->pixels + i * 4;
+            if (px[3] == 0) {
+                indices[i] = 0;
+                continue;
+            }
+            uint32_t colour = pack_colour(px);
+            int index = (int)hmgeti(lookup, colour);
+            if (index >= 0) {
+                indices[i] = (unsigned char)lookup[index].value;
+                continue;
+            }
+            if (atlas->palette_colours >= SPRITE_PALETTE_SIZE) {
+                fits = false;
+                break;
+            }
+            row[atlas->palette_colours] = colour;
+            hmput(lookup, colour, atlas->palette_colours);
+            indices[i] = (unsigned char)atlas->palette_colours++;
+        }
+
+        if (!fits) {
+            for (int c = first_new; c < atlas->palette_colours; c++) {
+                hmdel(lookup, row[c]);
+            }
+            atlas->palette_colours = first_new;
+            free(indices);
+            printf("Sheet %s has too many colours for the palette, kept as rgba\n", sheet->path);
+            continue;
+        }
+        sheet->indices = indices;
+        indexed++;
+    }
+    hmfree(lookup);
+
+    atlas->palette_count = indexed > 0 ? 1 : 0;
+    strncpy(atlas->palette_names[0], "default", sizeof(atlas->palette_names[0]) - 1);
+    printf("Indexed %d of %d sheets, %d palette colours\n", indexed, (int)arrlen(sheets), atlas->palette_colours);
+}
+
+static bool parse_hex_colour(const char* text, unsigned char out[4]) {
+    unsigned int r, g, b, a = 255;
+    int n = sscanf(text, "#%02x%02x%02x%02x", &r, &g, &b, &a);
+    if (n < 3) {
+        return false;
+    }
+    out[0] = (unsigned char)r;
+    out[1] = (unsigned char)g;
+    out[2] = (unsigned char)b;
+    out[3] = (unsigned char)a;
+    return true;
+}
+
+// "palettes": { "name": { "#from": "#to", ... } }, each a copy of the sheets' palette with
+// some colours replaced
+static void parse_palettes(SpriteAtlas* atlas, cJSON* palettes) {
+    if (atlas->palette_count == 0 || !cJSON_IsObject(palettes)) {
+        return;
+    }
+    cJSON* swap = NULL;
+    cJSON_ArrayForEach(swap, palettes) {
+        if (atlas->palette_count >= SPRITE_MAX_PALETTES) {
+            fprintf(stderr, "Too many palettes, %s is skipped\n", swap->string);
+            break;
+        }
+        int p = atlas->palette_count++;
+        memcpy(atlas->palettes[p], atlas->palettes[0], sizeof(atlas->palettes[0]));
+        strncpy(atlas->palette_names[p], swap->string, sizeof(atlas->palette_names[p]) - 1);
+
+        cJSON* colour = NULL;
+        cJSON_ArrayForEach(colour, swap) {
+            unsigned char from[4], to[4];
+            if (!cJSON_IsString(colour) || !parse_hex_colour(colour->string, from) ||
+                !parse_hex_colour(colour->valuestring, to)) {
+                fprintf(stderr, "Bad colour in palette %s\n", swap->string);
+                continue;
+            }
+            uint32_t key = pack_colour(from);
+            for (int c = 1; c < atlas->palette_colours; c++) {
+                if (atlas->palettes[p][c] == key) {
+                    atlas->palettes[p][c] = pack_colour(to);
+                }
+            }
+        }
+    }
+}
+
+static bool packs_before(const PendingSheet* a, const PendingSheet* b) {
+    bool a_indexed = a->indices != NULL, b_indexed = b->indices != NULL;
+    if (a_indexed != b_indexed) {
+        return b_indexed;
+    }
+    return a->height > b->height;
+}
+
+// shelf packer: tallest sheets first, left to right along a shelf, a new shelf when the row
+// is full and a new page when the shelves are. rgba sheets go first, indexed ones start on
+// their own page. returns false if a sheet could not be placed
+static bool pack_sheets(SpriteAtlas* atlas, PendingSheet* sheets, int page_size) {
+    int count = (int)arrlen(sheets);
+    int* order = malloc(count * sizeof(int));
+    for (int i = 0; i < count; i++) order[i] = i;
+
+    // there are only a handful of sheets, an insertion sort is plenty
+    for (int i = 1; i < count; i++) {
+        int v = order[i], j = i - 1;
+        while (j >= 0 && packs_before(&sheets[v], &sheets[order[j]])) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = v;
+    }
+
+    int used_w[SPRITE_ATLAS_MAX_PAGES] = {0};
+    int used_h[SPRITE_ATLAS_MAX_PAGES] = {0};
+    int page = 0, cursor_x = 0, shelf_y = 0, shelf_h = 0;
+    bool ok = true;
+    bool placed = false;
+
+    for (int n = 0; n < count; n++) {
+        PendingSheet* sheet = &sheets[order[n]];
+        bool indexed = sheet->indices != NULL;
+        int w = sheet->width;
+        int h = sheet->height;
+        if (w > page_size || h > page_size) {
+            fprintf(stderr, "Sheet %s (%dx%d) is larger than an atlas page\n", sheet->path, w, h);
+            ok = false;
+            continue;
+        }
+
+        // the padding goes between sheets, never past the page edge
+        if (cursor_x + w > page_size) {
+            shelf_y += shelf_h + SPRITE_ATLAS_PADDING;
+            cursor_x = 0;
+            shelf_h = 0;
+        }
+        if (placed && indexed != atlas->pages[page].indexed) {
+            // past the last shelf, so the page is full for the check below
+            shelf_y = page_size;
+        }
+        if (shelf_y + h > page_size) {
+            if (page + 1 >= SPRITE_ATLAS_MAX_PAGES) {
+                fprintf(stderr, "Out of atlas pages packing %s\n", sheet->path);
+                ok = false;
+                continue;
+            }
+            page++;
+            cursor_x = shelf_y = shelf_h = 0;
+        }
+
+        atlas->pages[page].indexed = indexed;
+        placed = true;
+        sheet->page = page;
+        sheet->x = cursor_x;
+        sheet->y = shelf_y;
+        if (cursor_x + w > used_w[page]) used_w[page] = cursor_x + w;
+        if (shelf_y + h > used_h[page]) used_h[page] = shelf_y + h;
+        cursor_x += w + SPRITE_ATLAS_PADDING;
+        if (h > shelf_h) shelf_h = h;
     }
+    free(order);
 
-    sg_image img = sg_make_image(&(sg_image_desc) {
-        .width = width,
-        .height = height,
-        .pixel_format = SG_PIXELFORMAT_RGBA8,
-        .data.subimage[0][0] = {
-            .ptr = data,
-            .size = (size_t)(width * height * 4)
+    // pages are trimmed to what was actually used
+    // nothing packed means no pages, not one empty one
+    atlas->page_count = placed ? page + 1 : 0;
+    for (int p = 0; p < atlas->page_count; p++) {
+        SpriteAtlasPage* pg = &atlas->pages[p];
+        // rows of one byte pixels are kept to whole words, the default upload alignment
+        pg->width = pg->indexed ? (used_w[p] + 3) & ~3 : used_w[p];
+        pg->height = used_h[p];
+
+        int bytes = pg->indexed ? 1 : 4;
+        unsigned char* pixels = calloc((size_t)pg->width * pg->height, bytes);
+        for (int i = 0; i < count; i++) {
+            if (sheets[i].page != p) continue;
+            const unsigned char* src = pg->indexed ? sheets[i].indices : sheets[i].pixels;
+            for (int row = 0; row < sheets[i].height; row++) {
+                memcpy(pixels + ((size_t)(sheets[i].y + row) * pg->width + sheets[i].x) * bytes,
+                       src + (size_t)row * sheets[i].width * bytes,
+                       (size_t)sheets[i].width * bytes);
+            }
         }
-    });
 
-    stbi_image_free(data);
-    return img;
+        pg->image = sg_make_image(&(sg_image_desc) {
+            .width = pg->width,
+            .height = pg->height,
+            .pixel_format = pg->indexed ? SG_PIXELFORMAT_R8 : SG_PIXELFORMAT_RGBA8,
+            .data.subimage[0][0] = {
+                .ptr = pixels,
+                .size = (size_t)pg->width * pg->height * bytes
+            }
+        });
+        free(pixels);
+
+        printf("Atlas page %d: %dx%d%s\n", p, pg->width, pg->height, pg->indexed ? " indexed" : "");
+    }
+    return ok;
 }
 
 bool sprite_atlas_init(SpriteAtlas* atlas) {
-    atlas->entity_count = 0;
-    atlas->entities = NULL;
+    memset(atlas, 0, sizeof(SpriteAtlas));
     return true;
 }
 
@@ -69,8 +308,11 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
     }
     
     int sprite_count = cJSON_GetArraySize(sprites);
-    atlas->entities = malloc(sprite_count * sizeof(LoadedSpriteData));
+    atlas->entities = calloc(sprite_count, sizeof(LoadedSpriteData));
     atlas->entity_count = 0;
+
+    PendingSheet* sheets = NULL;
+    PendingClip* pending = NULL;
     
     cJSON *sprite = NULL;
     cJSON_ArrayForEach(sprite, sprites) {
@@ -84,6 +326,7 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
         cJSON* scale_x = cJSON_GetObjectItemCaseSensitive(sprite, "scale_x");
         cJSON* scale_y = cJSON_GetObjectItemCaseSensitive(sprite, "scale_y");
         cJSON* default_anim = cJSON_GetObjectItemCaseSensitive(sprite, "default_animation");
+        cJSON* palette = cJSON_GetObjectItemCaseSensitive(sprite, "palette");
         
         if (!cJSON_IsString(name)) {
             fprintf(stderr, "Sprite missing 'name'\n");
@@ -102,6 +345,9 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
         } else {
             entity->default_animation[0] = '\0';
         }
+        if (cJSON_IsString(palette)) {
+            strncpy(entity->palette_name, palette->valuestring, sizeof(entity->palette_name) - 1);
+        }
         
         // Parse animations
         cJSON* animations = cJSON_GetObjectItemCaseSensitive(sprite, "animations");
@@ -128,8 +374,14 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
                 continue;
             }
             
+            int sheet = load_sheet(&sheets, texture->valuestring);
+            if (sheet < 0) {
+                anim = anim->next;
+                continue;
+            }
+
             LoadedAnimationClip *clip = &entity->clips[entity->clip_count];
-            clip->texture = load_texture(texture->valuestring);
+            arrput(pending, ((PendingClip) { clip, sheet }));
             clip->frame_count = frame_count->valueint;
             clip->frame_time = cJSON_IsNumber(frame_time) ? frame_time->valuedouble : 0.1f;
             clip->loop = cJSON_IsBool(loop) ? cJSON_IsTrue(loop) : true;
@@ -143,12 +395,6 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
                 clip->direction_count = 1;
             }
             
-            if (sg_query_image_state(clip->texture) != SG_RESOURCESTATE_VALID) {
-                fprintf(stderr, "Failed to load texture: %s\n", texture->valuestring);
-                anim = anim->next;
-                continue;
-            }
-            
             strncpy(entity->clip_names[entity->clip_count], anim_name, 63);
             entity->clip_count++;
             
@@ -179,7 +425,7 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
                         LoadedTransition *t = &entity->transitions[entity->transition_count];
                         strncpy(t->from, from->valuestring, 63);
                         strncpy(t->to, to->valuestring, 63);
-                        t->condition = lookup_condition_function(condition->valuestring);
+                        t->condition = lookup_condition(condition->valuestring);
                         t->priority = cJSON_IsNumber(priority) ? priority->valueint : 1;
                         entity->transition_count++;
                     }
@@ -193,7 +439,73 @@ bool sprite_atlas_load(SpriteAtlas* atlas, const char* path) {
         atlas->entity_count++;
     }
     
+    // sheets and swaps have to be known before the pages are laid out
+    if (cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(json, "indexed"))) {
+        index_sheets(atlas, sheets);
+        parse_palettes(atlas, cJSON_GetObjectItemCaseSensitive(json, "palettes"));
+    }
     cJSON_Delete(json);
+
+    for (int i = 0; i < atlas->entity_count; i++) {
+        LoadedSpriteData* entity = &atlas->entities[i];
+        if (entity->palette_name[0] == '\0') {
+            continue;
+        }
+        entity->palette = sprite_atlas_palette(atlas, entity->palette_name);
+        if (entity->palette == 0) {
+            fprintf(stderr, "Sprite %s uses unknown palette %s\n", entity->name, entity->palette_name);
+        }
+    }
+
+    int page_size = SPRITE_ATLAS_PAGE_SIZE;
+    int max_size = sg_query_limits().max_image_size_2d;
+    if (max_size > 0 && max_size < page_size) {
+        page_size = max_size;
+    }
+    pack_sheets(atlas, sheets, page_size);
+
+    if (atlas->palette_count > 0) {
+        atlas->palette = sg_make_image(&(sg_image_desc) {
+            .width = SPRITE_PALETTE_SIZE,
+            .height = atlas->palette_count,
+            .pixel_format = SG_PIXELFORMAT_RGBA8,
+            .data.subimage[0][0] = {
+                .ptr = atlas->palettes,
+                .size = (size_t)atlas->palette_count * sizeof(atlas->palettes[0])
+            },
+            .label = "sprite-palettes"
+        });
+    }
+
+    // point every clip at its sheet inside the page
+    for (int i = 0; i < arrlen(pending); i++) {
+        LoadedAnimationClip* clip = pending[i].clip;
+        const PendingSheet* sheet = &sheets[pending[i].sheet];
+        if (sheet->page < 0) {
+            // the clip keeps its zeroed texture and uv, so it draws nothing
+            fprintf(stderr, "Sheet %s was not packed, its clips won't draw\n", sheet->path);
+            continue;
+        }
+        const SpriteAtlasPage* page = &atlas->pages[sheet->page];
+        clip->texture = page->image;
+        clip->page = sheet->page;
+        clip->atlas_x = sheet->x;
+        clip->atlas_y = sheet->y;
+        clip->sheet_w = sheet->width;
+        clip->sheet_h = sheet->height;
+        clip->uv[0] = (float)sheet->x / page->width;
+        clip->uv[1] = (float)sheet->y / page->height;
+        clip->uv[2] = (float)(sheet->x + sheet->width) / page->width;
+        clip->uv[3] = (float)(sheet->y + sheet->height) / page->height;
+    }
+
+    for (int i = 0; i < arrlen(sheets); i++) {
+        stbi_image_free(sheets[i].pixels);
+        free(sheets[i].indices);
+    }
+    arrfree(sheets);
+    arrfree(pending);
+
     return atlas->entity_count > 0;
 }
 
@@ -206,6 +518,15 @@ LoadedSpriteData* sprite_atlas_get(SpriteAtlas *atlas, const char *name) {
     return NULL;
 }
 
+int sprite_atlas_palette(const SpriteAtlas* atlas, const char* name) {
+    for (int i = 1; i < atlas->palette_count; i++) {
+        if (strcmp(atlas->palette_names[i], name) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
 void sprite_atlas_free(SpriteAtlas *atlas) {
     for (int i = 0; i < atlas->entity_count; i++) {
         if (atlas->entities[i].transitions) {
@@ -215,4 +536,11 @@ void sprite_atlas_free(SpriteAtlas *atlas) {
     free(atlas->entities);
     atlas->entities = NULL;
     atlas->entity_count = 0;
+
+    for (int i = 0; i < atlas->page_count; i++) {
+        sg_destroy_image(atlas->pages[i].image);
+    }
+    atlas->page_count = 0;
+    sg_destroy_image(atlas->palette);
+    atlas->palette_count = 0;
 }
\ No newline at end of file
@@ -7,10 +7,34 @@
 #include "components/animation_graph.h"
 
 #define INITIAL_SPRITE_ATLAS_CAPACITY 32
+#define SPRITE_ATLAS_PAGE_SIZE 4096   // clamped to the backend's max texture size
+#define SPRITE_ATLAS_MAX_PAGES 4
+#define SPRITE_ATLAS_PADDING 2        // transparent gutter so filtering never bleeds into a neighbour
+#define SPRITE_PALETTE_SIZE 256       // colours in a palette, index 0 is transparent
+#define SPRITE_MAX_PALETTES 16        // the sheets' own colours plus the swaps
+
+// every clip sheet is packed into one of a few large pages at load time, so sprites of any
+// type can be drawn back to back without switching textures.
+//
+// with "indexed" set in the definitions, sheets whose colours fit in the shared palette go on
+// indexed pages instead: one byte per pixel (R8) holding a palette index, turned back into a
+// colour by the sprite shader. a quarter of the memory and bandwidth, and drawing a sprite with
+// another palette row (a swap named in "palettes", picked by a sprite's "palette") recolours it
+// for free. sheets that don't fit stay RGBA8
+typedef struct {
+    sg_image image;
+    int width, height;
+    bool indexed;
+} SpriteAtlasPage;
 
 // Loaded animation clip (temporary)
 typedef struct {
-    sg_image texture;
+    sg_image texture;        // the atlas page the sheet was packed into
+    int page;
+    int atlas_x, atlas_y;    // top-left of the sheet inside the page, in pixels
+    int sheet_w, sheet_h;
+    float uv[4];             // sheet rect in page uv space (u0, v0, u1, v1)
+    int shader_clip;         // slot in the sprite shader's clip table + 1, 0 if none
     int frame_count;
     int direction_count;
     float frame_time;
@@ -22,7 +46,7 @@ typedef struct {
 typedef struct {
     char from[64];
     char to[64];
-    AnimationConditionFunc condition;
+    int condition;           // see lookup_condition, -1 if unknown
     int priority;
 } LoadedTransition;
 
@@ -32,6 +56,8 @@ typedef struct {
     int width, height;
     float scale_x, scale_y;
     char default_animation[64];
+    char palette_name[32];   // "palette" in the definition, empty for the sheets' own colours
+    int palette;             // its row, resolved once the swaps are parsed
     
     LoadedAnimationClip clips[16];
     char clip_names[16][64];
@@ -45,12 +71,22 @@ typedef struct {
 typedef struct {
     LoadedSpriteData *entities;
     int entity_count;
+    SpriteAtlasPage pages[SPRITE_ATLAS_MAX_PAGES];
+    int page_count;
+
+    // row 0 is the sheets' colours, the rest are swaps of it. rgba8 packed
+    uint32_t palettes[SPRITE_MAX_PALETTES][SPRITE_PALETTE_SIZE];
+    char palette_names[SPRITE_MAX_PALETTES][32];
+    int palette_count;
+    int palette_colours;     // used entries of a row, transparent included
+    sg_image palette;        // SPRITE_PALETTE_SIZE x palette_count, invalid without indexed pages
 } SpriteAtlas;
 
 bool sprite_atlas_init(SpriteAtlas* atlas);
 bool sprite_atlas_load(SpriteAtlas* atlas, const char* path);
 LoadedSpriteData* sprite_atlas_get(SpriteAtlas *atlas, const char *name);
-void sprite_atlas_shutdown(SpriteAtlas* atlas);
-AnimationConditionFunc lookup_condition_function(const char *name);
+// row of a palette swap for Sprite.palette, 0 (the sheets' own colours) if there's no such swap
+int sprite_atlas_palette(const SpriteAtlas* atlas, const char* name);
+void sprite_atlas_free(SpriteAtlas* atlas);
 
 #endif
\ No newline at end of file
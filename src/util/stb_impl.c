@@ -1,5 +1,8 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
 #define STB_DS_IMPLEMENTATION
 #include "stb_ds.h"
\ No newline at end of file
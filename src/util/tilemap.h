@@ -0,0 +1,61 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sokol_gfx.h"
+#include "systems/sprite_batch.h"
+
+// static tile layers loaded from a Tiled map. layers are baked per chunk into immutable
+// instance buffers (see systems/tilemap_render.c) and only rebaked when a tile changes
+
+#define TILEMAP_CHUNK_SIZE 16       // tiles per chunk side
+#define TILEMAP_GID_MASK 0x0FFFFFFF // strips Tiled's flip flags
+
+typedef struct {
+    char name[64];
+    uint32_t* gids;  // width * height, 0 is empty
+} MapLayer;
+
+typedef struct {
+    int firstgid;
+    int columns;
+    int tile_w, tile_h;   // size of one tile image, may be taller than the map grid
+    int margin, spacing;
+    int image_w, image_h;
+    sg_image image;
+} MapTileset;
+
+// consecutive tiles in a baked chunk that use the same tileset, drawn with one call
+typedef struct {
+    int tileset;
+    int first, count;
+} MapChunkRun;
+
+// buffer, runs and bounds belong to the thread that draws, dirty to the one that edits tiles
+typedef struct {
+    sg_buffer buffer;       // immutable, one SpriteInstance per non-empty tile
+    MapChunkRun* runs;      // stb_ds array
+    float x0, y0, x1, y1;   // world bounds of everything in the chunk
+    bool dirty;
+} MapChunk;
+
+// a chunk rebaked on the cpu during extraction, uploaded by the renderer with the frame
+typedef struct {
+    int chunk;                  // index into TileMap.chunks
+    SpriteInstance* instances;  // stb_ds array, freed once uploaded
+    MapChunkRun* runs;          // stb_ds array, handed over to the chunk
+    float x0, y0, x1, y1;
+} MapChunkBake;
+
+// fills in the tile-specific parts of Map (see common.h)
+typedef struct {
+    int tile_width, tile_height;  // map grid in pixels
+    bool isometric;
+    MapLayer* layers;             // stb_ds array, bottom layer first
+    MapTileset* tilesets;         // stb_ds array, ordered by firstgid
+    MapChunk* chunks;             // chunks_x * chunks_y
+    int chunks_x, chunks_y;
+} TileMap;
+
+#endif
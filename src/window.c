@@ -10,16 +10,24 @@ bool window_init(void *appstate, const char* title, int width, int height) {
         return false;
     }
 
+#ifdef RENDER_HEADLESS
+    // no display on ci, sdl only provides the app callbacks, events and threads
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+#endif
+
     // Initialize SDL3 with video subsystem
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         fprintf(stderr, "Failed to initialize SDL: %s\n", SDL_GetError());
         return false;
     }
 
-    // Set platform-specific window flags
-    SDL_WindowFlags window_flags = SDL_WINDOW_RESIZABLE;
+    // Set platform-specific window flags. the backbuffer gets the display's real pixel count
+    SDL_WindowFlags window_flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY;
     
-#ifdef SOKOL_D3D11
+#if defined(RENDER_HEADLESS)
+    // the headless backend makes its own context, the window is never shown
+    window_flags |= SDL_WINDOW_HIDDEN;
+#elif defined(SOKOL_D3D11)
     // No special flags needed for D3D11
 #elif defined(SOKOL_GLCORE)
     window_flags |= SDL_WINDOW_OPENGL;
@@ -52,8 +60,13 @@ bool window_init(void *appstate, const char* title, int width, int height) {
     state->width = width;
     state->height = height;
     state->title = title;
+    if (!SDL_GetWindowSizeInPixels(state->window, &state->pixel_width, &state->pixel_height)) {
+        state->pixel_width = width;
+        state->pixel_height = height;
+    }
 
-    printf("Window created successfully: %dx%d\n", width, height);
+    printf("Window created successfully: %dx%d (%dx%d pixels)\n", width, height,
+           state->pixel_width, state->pixel_height);
     return true;
 }
 
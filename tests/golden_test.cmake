@@ -0,0 +1,39 @@
+# runs the headless build for a few frames, captures the last one and diffs it against the
+# golden image. with UPDATE set the capture replaces the golden image instead
+#
+#   cmake -DAPP=... -DDIFF=... -DREFERENCE=... -DOUTPUT=... -DFRAMES=N [-DUPDATE=ON] -P golden_test.cmake
+
+math(EXPR CAPTURE_FRAME "${FRAMES} - 1")
+file(REMOVE ${OUTPUT})
+
+execute_process(
+    COMMAND ${APP} --frames ${FRAMES} --capture ${CAPTURE_FRAME} ${OUTPUT}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0 OR NOT EXISTS ${OUTPUT})
+    message(FATAL_ERROR "Headless run failed (${result}), no frame captured")
+endif()
+
+if(UPDATE)
+    get_filename_component(REFERENCE_DIR ${REFERENCE} DIRECTORY)
+    file(MAKE_DIRECTORY ${REFERENCE_DIR})
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OUTPUT} ${REFERENCE})
+    message(STATUS "Golden image updated: ${REFERENCE}")
+    return()
+endif()
+
+# a fresh golden image is made with the update_golden_images target on a machine that can
+# render, there's nothing to compare against until then
+if(NOT EXISTS ${REFERENCE})
+    # ctest reports this as skipped, see SKIP_REGULAR_EXPRESSION
+    message(STATUS "No golden image at ${REFERENCE}, build update_golden_images to make one")
+    return()
+endif()
+
+execute_process(
+    COMMAND ${DIFF} ${REFERENCE} ${OUTPUT}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Frame ${CAPTURE_FRAME} doesn't match ${REFERENCE}, the capture is at ${OUTPUT}")
+endif()
@@ -0,0 +1,59 @@
+// compares a captured frame against its golden image. a pixel counts as different when any
+// channel is off by more than the channel tolerance, the images match while the share of
+// different pixels stays under the pixel tolerance. gpus and drivers round a little
+// differently and the fps label changes from run to run, so exact matches aren't asked for
+//
+//   image_diff EXPECTED.png ACTUAL.png [CHANNEL_TOLERANCE] [PIXEL_TOLERANCE]
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s EXPECTED.png ACTUAL.png [CHANNEL_TOLERANCE] [PIXEL_TOLERANCE]\n", argv[0]);
+        return 2;
+    }
+    int channel_tolerance = argc > 3 ? atoi(argv[3]) : 8;
+    double pixel_tolerance = argc > 4 ? atof(argv[4]) : 0.01;
+
+    int ew, eh, aw, ah;
+    unsigned char* expected = stbi_load(argv[1], &ew, &eh, NULL, 4);
+    if (!expected) {
+        fprintf(stderr, "Failed to load %s: %s\n", argv[1], stbi_failure_reason());
+        return 2;
+    }
+    unsigned char* actual = stbi_load(argv[2], &aw, &ah, NULL, 4);
+    if (!actual) {
+        fprintf(stderr, "Failed to load %s: %s\n", argv[2], stbi_failure_reason());
+        stbi_image_free(expected);
+        return 2;
+    }
+    if (ew != aw || eh != ah) {
+        fprintf(stderr, "Size differs: expected %dx%d, got %dx%d\n", ew, eh, aw, ah);
+        stbi_image_free(expected);
+        stbi_image_free(actual);
+        return 1;
+    }
+
+    long long different = 0;
+    int worst = 0;
+    long long pixels = (long long)ew * eh;
+    for (long long i = 0; i < pixels; i++) {
+        int off = 0;
+        for (int c = 0; c < 4; c++) {
+            int d = abs(expected[i * 4 + c] - actual[i * 4 + c]);
+            if (d > off) off = d;
+        }
+        if (off > worst) worst = off;
+        if (off > channel_tolerance) different++;
+    }
+    stbi_image_free(expected);
+    stbi_image_free(actual);
+
+    double share = (double)different / pixels;
+    printf("%lld of %lld pixels differ (%.3f%%, allowed %.3f%%), largest channel difference %d\n",
+           different, pixels, share * 100.0, pixel_tolerance * 100.0, worst);
+    return share <= pixel_tolerance ? 0 : 1;
+}